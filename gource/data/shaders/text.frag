@@ -7,13 +7,28 @@ in vec2 v_texcoord;
 uniform sampler2D u_texture;
 uniform float u_shadow_strength;
 uniform float u_texel_size;
+uniform bool u_sdf;
 
 out vec4 fragColor;
 
+// Font texture uses GL_RED format - sample from red channel for glyph alpha.
+// Distance field glyphs are 0.5 at the outline, antialiased over a pixel
+float glyphAlpha(vec2 texcoord) {
+    float value = texture(u_texture, texcoord).r;
+
+    if (!u_sdf) return value;
+
+    float edge_width = max(fwidth(value) * 0.5, 0.001);
+
+    return smoothstep(0.5 - edge_width, 0.5 + edge_width, value);
+}
+
 void main() {
-    // Font texture uses GL_RED format - sample from red channel for glyph alpha
-    float colour_alpha = texture(u_texture, v_texcoord).r;
-    float shadow_alpha = texture(u_texture, v_texcoord - vec2(u_texel_size)).r * u_shadow_strength;
+    // Distance field glyphs are scaled, so offset the shadow by a screen pixel
+    vec2 shadow_offset = u_sdf ? fwidth(v_texcoord) : vec2(u_texel_size);
+
+    float colour_alpha = glyphAlpha(v_texcoord);
+    float shadow_alpha = glyphAlpha(v_texcoord - shadow_offset) * u_shadow_strength;
 
     float combined_alpha = 1.0 - (1.0 - shadow_alpha) * (1.0 - colour_alpha);
 
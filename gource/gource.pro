@@ -32,14 +32,19 @@ VPATH += ./src
 
 SOURCES += \
     action.cpp \
+    actionqueue.cpp \
+    activity.cpp \
+    avatars.cpp \
     bloom.cpp \
     caption.cpp \
     dirnode.cpp \
     file.cpp \
+    filestore.cpp \
     gource.cpp \
     gource_settings.cpp \
     gource_shell.cpp \
     key.cpp \
+    labelgrid.cpp \
     logmill.cpp \
     main.cpp \
     pawn.cpp \
@@ -57,6 +62,7 @@ SOURCES += \
     formats/git.cpp \
     formats/gitraw.cpp \
     formats/hg.cpp \
+    formats/merged.cpp \
     formats/svn.cpp \
     tinyxml/tinystr.cpp \
     tinyxml/tinyxml.cpp \
@@ -80,22 +86,29 @@ SOURCES += \
     core/shader.cpp \
     core/shader_common.cpp \
     core/stringhash.cpp \
+    core/stringtable.cpp \
     core/texture.cpp \
     core/tga.cpp \
+    core/tiled_render.cpp \
     core/timezone.cpp \
     core/vbo.cpp \
     core/vectors.cpp
 
 HEADERS += \
     action.h \
+    actionqueue.h \
+    activity.h \
+    avatars.h \
     bloom.h \
     caption.h \
     dirnode.h \
     file.h \
+    filestore.h \
     gource.h \
     gource_settings.h \
     gource_shell.h \
     key.h \
+    labelgrid.h \
     logmill.h \
     main.h \
     pawn.h \
@@ -113,6 +126,7 @@ HEADERS += \
     formats/git.h \
     formats/gitraw.h \
     formats/hg.h \
+    formats/merged.h \
     formats/svn.h \
     tinyxml/tinystr.h \
     tinyxml/tinyxml.h \
@@ -137,8 +151,10 @@ HEADERS += \
     core/shader.h \
     core/shader_common.h \
     core/stringhash.h \
+    core/stringtable.h \
     core/texture.h \
     core/tga.h \
+    core/tiled_render.h \
     core/timezone.h \
     core/vbo.h \
     core/vectors.h
@@ -42,6 +42,17 @@ void RAction::logic(float dt) {
     progress = std::min(progress + action_rate * dt, 1.0f);
 }
 
+// apply the action straight away, without it being drawn
+void RAction::finish() {
+    if(progress >= 1.0) return;
+
+    if(progress == 0.0) {
+        apply();
+    }
+
+    progress = 1.0;
+}
+
 void RAction::drawToVBO(quadbuf& buffer) const {
     if(isFinished()) return;
 
@@ -122,6 +133,14 @@ void RemoveAction::logic(float dt) {
     }
 }
 
+void RemoveAction::finish() {
+    if(isFinished()) return;
+
+    RAction::finish();
+
+    target->remove(timestamp);
+}
+
 ModifyAction::ModifyAction(RUser* source, RFile* target, time_t timestamp, float t, const vec3& modify_colour)
     : RAction(source, target, timestamp, t, vec3(1.0f, 0.7f, 0.3f)), modify_colour(modify_colour) {
 }
@@ -44,6 +44,7 @@ public:
     inline bool isFinished() const { return (progress >= 1.0); };
 
     virtual void logic(float dt);
+    virtual void finish();
 
     void drawToVBO(quadbuf& buffer) const ;
     void draw(float dt);
@@ -59,6 +60,7 @@ public:
     RemoveAction(RUser* source, RFile* target, time_t timestamp, float t);
 
     void logic(float dt);
+    void finish();
 };
 
 class ModifyAction : public RAction {
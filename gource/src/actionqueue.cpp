@@ -0,0 +1,210 @@
+// === File: src/actionqueue.cpp ===============================================
+// AGENT: PURPOSE    — Pending actions of a user, indexed by time and directory
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "actionqueue.h"
+#include "action.h"
+#include "file.h"
+#include "core/pi.h"
+
+#include <cmath>
+
+// RQueuedDir
+
+bool RQueuedDir::hasSectors(RDirNode* dir) const {
+    return layout == dir->getFileLayout();
+}
+
+// RActionQueue
+
+RActionQueue::RActionQueue() {
+    next_seq = 0;
+}
+
+RAction* RActionQueue::front() const {
+    if(queued.empty()) return 0;
+
+    return queued.begin()->second.action;
+}
+
+void RActionQueue::push(RAction* action) {
+
+    size_t seq = next_seq++;
+
+    RQueuedAction& entry = queued[seq];
+
+    entry.action = action;
+    entry.dir    = action->target->getDir();
+    entry.time   = times.insert(std::make_pair(action->t, seq));
+
+    RQueuedDir& queued_dir = dirs[entry.dir];
+
+    queued_dir.actions[seq] = action;
+
+    if(queued_dir.hasSectors(entry.dir)) {
+        int sector = getSector(action);
+
+        if(sector >= 0) queued_dir.sectors[sector][seq] = action;
+    }
+}
+
+RAction* RActionQueue::take(std::map<size_t, RQueuedAction>::iterator it) {
+
+    RQueuedAction& entry = it->second;
+
+    RAction* action = entry.action;
+
+    std::map<RDirNode*, RQueuedDir>::iterator dir_it = dirs.find(entry.dir);
+
+    RQueuedDir& queued_dir = dir_it->second;
+
+    queued_dir.actions.erase(it->first);
+
+    // the layout has not changed so the file is in the same sector
+    if(queued_dir.hasSectors(entry.dir)) {
+        int sector = getSector(action);
+
+        if(sector >= 0) queued_dir.sectors[sector].erase(it->first);
+    }
+
+    if(queued_dir.actions.empty()) dirs.erase(dir_it);
+
+    times.erase(entry.time);
+    queued.erase(it);
+
+    return action;
+}
+
+// the oldest action with a time before t
+
+RAction* RActionQueue::popOlderThan(float t) {
+
+    if(times.empty() || times.begin()->first >= t) return 0;
+
+    return take(queued.find(times.begin()->second));
+}
+
+// sector of an angle in radians
+
+int RActionQueue::getSector(float angle) {
+
+    int sector = (int) floorf((angle + PI) / (2.0f * PI) * RACTIONQUEUE_SECTORS);
+
+    return ((sector % RACTIONQUEUE_SECTORS) + RACTIONQUEUE_SECTORS) % RACTIONQUEUE_SECTORS;
+}
+
+// sector of the place of the action's file in its directory. files placed
+// at the centre, including hidden files, are in no sector. they can only be
+// in range when the directory itself is, and then all actions are checked.
+
+int RActionQueue::getSector(RAction* action) {
+
+    vec2 dest = action->target->getDest();
+
+    if(dest.x == 0.0f && dest.y == 0.0f) return -1;
+
+    return getSector(atan2f(dest.y, dest.x));
+}
+
+void RActionQueue::updateSectors(RDirNode* dir, RQueuedDir& queued_dir) {
+
+    if(queued_dir.hasSectors(dir)) return;
+
+    queued_dir.sectors.assign(RACTIONQUEUE_SECTORS, std::map<size_t, RAction*>());
+
+    for(std::map<size_t, RAction*>::iterator it = queued_dir.actions.begin(); it != queued_dir.actions.end(); it++) {
+        int sector = getSector(it->second);
+
+        if(sector >= 0) queued_dir.sectors[sector].insert(*it);
+    }
+
+    queued_dir.layout = dir->getFileLayout();
+}
+
+// the first action queued before best with a file within distance of pos
+
+void RActionQueue::findInRange(const std::map<size_t, RAction*>& actions, const vec2& pos, float distance, size_t& best, bool& found) {
+
+    for(std::map<size_t, RAction*>::const_iterator it = actions.begin(); it != actions.end(); it++) {
+
+        // queued after an action already found
+        if(found && it->first > best) return;
+
+        if(glm::length(it->second->target->getAbsolutePos() - pos) < distance) {
+            best  = it->first;
+            found = true;
+            return;
+        }
+    }
+}
+
+// the first queued action with a file within distance of pos.
+//
+// all of the circle around pos lies within asin(distance / d) radians of the
+// direction of pos from a directory d away, so when the directory is large
+// only the actions of files placed in those sectors need to be checked.
+// files still moving to a new place are found once they arrive.
+
+RAction* RActionQueue::popInRange(const vec2& pos, float distance) {
+
+    size_t best = 0;
+    bool found  = false;
+
+    for(std::map<RDirNode*, RQueuedDir>::iterator it = dirs.begin(); it != dirs.end(); it++) {
+
+        RDirNode* dir = it->first;
+        RQueuedDir& queued_dir = it->second;
+
+        vec2 offset = pos - dir->getPos();
+
+        float dir_distance = glm::length(offset);
+
+        // no file of this directory is close enough
+        if(dir_distance >= distance + dir->getFilesExtent()) continue;
+
+        if(dir_distance <= distance || queued_dir.actions.size() < RACTIONQUEUE_SECTOR_MIN_ACTIONS) {
+            findInRange(queued_dir.actions, pos, distance, best, found);
+            continue;
+        }
+
+        updateSectors(dir, queued_dir);
+
+        float angle  = atan2f(offset.y, offset.x);
+        float spread = asinf(distance / dir_distance);
+
+        int first = (int) floorf((angle - spread + PI) / (2.0f * PI) * RACTIONQUEUE_SECTORS);
+        int last  = (int) floorf((angle + spread + PI) / (2.0f * PI) * RACTIONQUEUE_SECTORS);
+
+        last = std::min(last, first + RACTIONQUEUE_SECTORS - 1);
+
+        for(int i = first; i <= last; i++) {
+            int sector = ((i % RACTIONQUEUE_SECTORS) + RACTIONQUEUE_SECTORS) % RACTIONQUEUE_SECTORS;
+
+            findInRange(queued_dir.sectors[sector], pos, distance, best, found);
+        }
+    }
+
+    if(!found) return 0;
+
+    return take(queued.find(best));
+}
+
+// remove the actions of a file. the file must still be in its directory.
+
+void RActionQueue::removeTarget(RFile* file, std::vector<RAction*>& removed) {
+
+    std::map<RDirNode*, RQueuedDir>::iterator dir_it = dirs.find(file->getDir());
+
+    if(dir_it == dirs.end()) return;
+
+    std::vector<size_t> seqs;
+
+    for(std::map<size_t, RAction*>::iterator it = dir_it->second.actions.begin(); it != dir_it->second.actions.end(); it++) {
+        if(it->second->target == file) seqs.push_back(it->first);
+    }
+
+    for(size_t i = 0; i < seqs.size(); i++) {
+        removed.push_back(take(queued.find(seqs[i])));
+    }
+}
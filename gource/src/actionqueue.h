@@ -0,0 +1,84 @@
+// === File: src/actionqueue.h =================================================
+// AGENT: PURPOSE    — Pending actions of a user, indexed by time and directory
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef RACTIONQUEUE_H
+#define RACTIONQUEUE_H
+
+#include "core/vectors.h"
+
+#include <map>
+#include <vector>
+
+// number of angular sectors the actions of a directory are divided into
+#define RACTIONQUEUE_SECTORS 64
+
+// directories with fewer queued actions are searched without the sectors
+#define RACTIONQUEUE_SECTOR_MIN_ACTIONS 64
+
+class RAction;
+class RDirNode;
+class RFile;
+
+class RQueuedAction {
+public:
+    RAction* action;
+    RDirNode* dir;
+    std::multimap<float, size_t>::iterator time;
+};
+
+// the actions queued for the files of one directory, in queue order and
+// divided into sectors by the angle of each file's place in the directory.
+// the sectors are rebuilt when the file layout of the directory changes.
+
+class RQueuedDir {
+public:
+    std::map<size_t, RAction*> actions;
+    std::vector< std::map<size_t, RAction*> > sectors;
+    int layout;
+
+    RQueuedDir() : layout(-1) {};
+
+    bool hasSectors(RDirNode* dir) const;
+};
+
+// actions are numbered in the order they are queued. besides that order,
+// they are indexed by time, so actions older than max-file-lag are found
+// without a scan, and by the directory of their file, so finding the first
+// action within reach of the user only looks at directories whose files
+// could be within reach, and within large directories only at the sectors
+// facing the user.
+
+class RActionQueue {
+    size_t next_seq;
+
+    std::map<size_t, RQueuedAction> queued;
+    std::multimap<float, size_t> times;
+    std::map<RDirNode*, RQueuedDir> dirs;
+
+    RAction* take(std::map<size_t, RQueuedAction>::iterator it);
+
+    static int getSector(float angle);
+    static int getSector(RAction* action);
+
+    void updateSectors(RDirNode* dir, RQueuedDir& queued_dir);
+
+    static void findInRange(const std::map<size_t, RAction*>& actions, const vec2& pos, float distance, size_t& best, bool& found);
+public:
+    RActionQueue();
+
+    size_t size() const { return queued.size(); };
+    bool empty() const  { return queued.empty(); };
+
+    RAction* front() const;
+
+    void push(RAction* action);
+
+    RAction* popOlderThan(float t);
+    RAction* popInRange(const vec2& pos, float distance);
+
+    void removeTarget(RFile* file, std::vector<RAction*>& removed);
+};
+
+#endif
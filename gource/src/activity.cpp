@@ -0,0 +1,264 @@
+// === File: src/activity.cpp ===================================================
+// AGENT: PURPOSE    — Log activity summary used by the position slider and time warp
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "activity.h"
+#include "gource_settings.h"
+
+#include <cmath>
+
+// number of days either side of a time used to estimate activity
+#define ACTIVITY_DENSITY_DAYS 3
+
+// RActivityBucket
+
+RActivityBucket::RActivityBucket() {
+    min_timestamp = 0;
+    max_timestamp = 0;
+    commits = 0;
+    files   = 0;
+}
+
+// RActivityIndex
+
+RActivityIndex::RActivityIndex(int bucket_count) {
+    buckets.resize(std::max(1, bucket_count));
+    max_commits   = 0;
+    total_commits = 0;
+    complete      = false;
+    read_percent  = 0.0f;
+    skip_percent  = -1.0f;
+    contiguous    = true;
+}
+
+void RActivityIndex::clear() {
+    size_t bucket_count = buckets.size();
+
+    buckets.clear();
+    buckets.resize(bucket_count);
+    day_commits.clear();
+
+    max_commits   = 0;
+    total_commits = 0;
+    complete      = false;
+    read_percent  = 0.0f;
+    skip_percent  = -1.0f;
+    contiguous    = true;
+    unrecorded.clear();
+}
+
+int RActivityIndex::getBucketIndex(float percent) const {
+    int index = (int) (percent * buckets.size());
+
+    return std::max(0, std::min((int)buckets.size()-1, index));
+}
+
+// read through the log once, then return to the start
+bool RActivityIndex::build(RCommitLog* commitlog) {
+
+    clear();
+
+    if(!commitlog->isSeekable()) return false;
+
+    commitlog->seekTo(0.0f);
+
+    while(!commitlog->isFinished() && !gGourceSettings.shutdown) {
+
+        RCommit commit;
+
+        if(!commitlog->nextCommit(commit)) continue;
+
+        // where the commit was read, rather than how far the log has been
+        // read ahead to reorder commits
+        add(commitlog->getCommitPercent(), commit);
+    }
+
+    commitlog->seekTo(0.0f);
+
+    complete = !gGourceSettings.shutdown;
+
+    return complete;
+}
+
+// add a commit read during playback. commits may arrive out of order when
+// they are reordered, so the part of the log already indexed is only
+// skipped after seeking back into it, apart from commits the seek
+// discarded before they were recorded.
+void RActivityIndex::record(float percent, const RCommit& commit) {
+    if(complete) return;
+
+    if(percent <= skip_percent && unrecorded.erase(percent) == 0) return;
+
+    add(percent, commit);
+
+    read_percent = std::max(read_percent, percent);
+}
+
+// skipping ahead leaves part of the log unread, while seeking back means
+// the commits up to the furthest read are read again
+void RActivityIndex::seekTo(float percent, const std::multiset<float>& pending_percents) {
+    if(percent > read_percent) {
+        contiguous = false;
+    } else if(total_commits > 0) {
+        skip_percent = std::max(skip_percent, read_percent);
+    }
+
+    // commits read ahead to be reordered were never recorded. the seek
+    // discards them, and they are only read again if they are after it
+    for(float pending_percent : pending_percents) {
+        if(pending_percent < percent) {
+            contiguous = false;
+        } else if(pending_percent <= skip_percent) {
+            unrecorded.insert(pending_percent);
+        }
+    }
+}
+
+// the end of the log has been reached
+void RActivityIndex::finish() {
+    if(contiguous) complete = true;
+}
+
+void RActivityIndex::add(float percent, const RCommit& commit) {
+
+    RActivityBucket& bucket = buckets[getBucketIndex(percent)];
+
+    if(bucket.commits == 0) {
+        bucket.min_timestamp = bucket.max_timestamp = commit.timestamp;
+    } else {
+        bucket.min_timestamp = std::min(bucket.min_timestamp, commit.timestamp);
+        bucket.max_timestamp = std::max(bucket.max_timestamp, commit.timestamp);
+    }
+
+    bucket.commits++;
+    bucket.files += commit.files.size();
+
+    max_commits = std::max(max_commits, bucket.commits);
+
+    day_commits[commit.timestamp / 86400]++;
+    total_commits++;
+}
+
+bool RActivityIndex::isComplete() const {
+    return complete;
+}
+
+int RActivityIndex::size() const {
+    return buckets.size();
+}
+
+const RActivityBucket& RActivityIndex::getBucket(int index) const {
+    return buckets[index];
+}
+
+// relative number of commits in the busiest bucket of a range (0.0 - 1.0)
+float RActivityIndex::getActivity(float start_percent, float end_percent) const {
+    if(max_commits == 0) return 0.0f;
+
+    int start_index = getBucketIndex(start_percent);
+    int end_index   = std::max(start_index, getBucketIndex(end_percent));
+
+    int commits = 0;
+
+    for(int i = start_index; i <= end_index; i++) {
+        commits = std::max(commits, buckets[i].commits);
+    }
+
+    return (float) commits / (float) max_commits;
+}
+
+// timestamp of the first commit at or after a position in the log
+bool RActivityIndex::getTimestampAt(float percent, time_t& timestamp) const {
+
+    for(int i = getBucketIndex(percent); i < buckets.size(); i++) {
+        const RActivityBucket& bucket = buckets[i];
+
+        if(bucket.commits > 0) {
+            timestamp = bucket.min_timestamp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// a position in the log before the first commit at or after the specified time.
+// commit positions are recorded after the parser may have read ahead a line,
+// so return the start of the preceding bucket.
+float RActivityIndex::getPercentAt(time_t timestamp) const {
+
+    for(int i = 0; i < buckets.size(); i++) {
+        const RActivityBucket& bucket = buckets[i];
+
+        if(bucket.commits > 0 && bucket.max_timestamp >= timestamp) {
+            return (float) std::max(0, i-1) / (float) buckets.size();
+        }
+    }
+
+    return 1.0f;
+}
+
+// earliest and latest commit times in the log
+bool RActivityIndex::getTimeRange(time_t& first, time_t& last) const {
+
+    bool found = false;
+
+    for(int i = 0; i < buckets.size(); i++) {
+        const RActivityBucket& bucket = buckets[i];
+
+        if(bucket.commits == 0) continue;
+
+        if(!found || bucket.min_timestamp < first) first = bucket.min_timestamp;
+        if(!found || bucket.max_timestamp > last)  last  = bucket.max_timestamp;
+
+        found = true;
+    }
+
+    return found;
+}
+
+// commits per day around a point in time, weighted by distance so the
+// density changes smoothly as the time advances
+float RActivityIndex::getDensity(time_t timestamp) const {
+
+    double day = (double) timestamp / 86400.0;
+
+    std::map<time_t, int>::const_iterator it = day_commits.lower_bound((time_t) day - ACTIVITY_DENSITY_DAYS);
+
+    float density = 0.0f;
+
+    for(;it != day_commits.end(); it++) {
+        double distance = fabs(day - ((double) it->first + 0.5));
+
+        if(distance >= ACTIVITY_DENSITY_DAYS) {
+            if(it->first > day) break;
+            continue;
+        }
+
+        density += it->second * (1.0 - distance / ACTIVITY_DENSITY_DAYS);
+    }
+
+    return density / (float) ACTIVITY_DENSITY_DAYS;
+}
+
+// average commits per day between the first and last commit
+float RActivityIndex::getMeanDensity() const {
+    if(day_commits.empty()) return 0.0f;
+
+    time_t days = day_commits.rbegin()->first - day_commits.begin()->first + 1;
+
+    return (float) total_commits / (float) days;
+}
+
+// speed multiplier at a point in time which compresses quiet periods and
+// expands busy ones relative to the average activity of the log
+float RActivityIndex::getTimeWarp(time_t timestamp, float min_warp, float max_warp) const {
+    if(total_commits == 0) return 1.0f;
+
+    float density = getDensity(timestamp);
+
+    if(density <= 0.0f) return max_warp;
+
+    return std::max(min_warp, std::min(max_warp, getMeanDensity() / density));
+}
@@ -0,0 +1,79 @@
+// === File: src/activity.h =====================================================
+// AGENT: PURPOSE    — Log activity summary used by the position slider and time warp
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef RACTIVITY_INDEX_H
+#define RACTIVITY_INDEX_H
+
+#include "formats/commitlog.h"
+
+#include <vector>
+#include <map>
+#include <set>
+
+class RActivityBucket {
+public:
+    time_t min_timestamp;
+    time_t max_timestamp;
+
+    int commits;
+    int files;
+
+    RActivityBucket();
+};
+
+// Summary of commit activity across a seekable log, divided into
+// equally sized buckets of log position so each bucket maps directly
+// to a horizontal span of the position slider.
+//
+// The index is either built up front by reading the whole log, or filled
+// in with record() as commits are read during playback. It is complete
+// once the log has been read to the end without skipping any of it.
+
+class RActivityIndex {
+    std::vector<RActivityBucket> buckets;
+    std::map<time_t, int> day_commits;
+
+    int max_commits;
+    int total_commits;
+    bool complete;
+
+    float read_percent;
+    float skip_percent;
+    std::set<float> unrecorded;
+    bool contiguous;
+
+    int getBucketIndex(float percent) const;
+public:
+    RActivityIndex(int bucket_count = 1024);
+
+    void clear();
+
+    bool build(RCommitLog* commitlog);
+
+    void add(float percent, const RCommit& commit);
+
+    void record(float percent, const RCommit& commit);
+    void seekTo(float percent, const std::multiset<float>& pending_percents);
+    void finish();
+
+    bool isComplete() const;
+
+    int size() const;
+    const RActivityBucket& getBucket(int index) const;
+
+    float getActivity(float start_percent, float end_percent) const;
+
+    bool getTimestampAt(float percent, time_t& timestamp) const;
+    float getPercentAt(time_t timestamp) const;
+
+    bool getTimeRange(time_t& first, time_t& last) const;
+
+    float getDensity(time_t timestamp) const;
+    float getMeanDensity() const;
+
+    float getTimeWarp(time_t timestamp, float min_warp, float max_warp) const;
+};
+
+#endif
@@ -0,0 +1,234 @@
+// === File: src/avatars.cpp ===================================================
+// AGENT: PURPOSE    — Loading of user images off the render thread
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "avatars.h"
+#include "user.h"
+
+#include <algorithm>
+
+extern "C" {
+static int avatar_decode_thread(void *arg) {
+    RAvatarLoader *loader = static_cast<RAvatarLoader*>(arg);
+
+    loader->decodeThread();
+
+    return 0;
+}
+};
+
+RAvatarLoader::RAvatarLoader(int workers) {
+    exiting  = false;
+    decoding = 0;
+
+    mutex        = SDL_CreateMutex();
+    cond         = SDL_CreateCond();
+    decoded_cond = SDL_CreateCond();
+
+    for(int i=0;i<workers;i++) {
+#if SDL_VERSION_ATLEAST(2,0,0)
+        SDL_Thread* thread = SDL_CreateThread( avatar_decode_thread, "avatar_loader", this );
+#else
+        SDL_Thread* thread = SDL_CreateThread( avatar_decode_thread, this );
+#endif
+        if(thread != 0) threads.push_back(thread);
+    }
+}
+
+RAvatarLoader::~RAvatarLoader() {
+
+    SDL_mutexP(mutex);
+
+        exiting = true;
+
+        SDL_CondBroadcast(cond);
+
+    SDL_mutexV(mutex);
+
+    for(size_t i=0;i<threads.size();i++) {
+        SDL_WaitThread(threads[i], 0);
+    }
+
+    threads.clear();
+
+    clear();
+
+    SDL_DestroyCond(decoded_cond);
+    SDL_DestroyCond(cond);
+    SDL_DestroyMutex(mutex);
+}
+
+void RAvatarLoader::decodeThread() {
+
+    SDL_mutexP(mutex);
+
+    while(1) {
+
+        while(!exiting && requests.empty()) {
+            SDL_CondWait(cond, mutex);
+        }
+
+        if(exiting) break;
+
+        std::string filename = requests.front();
+        requests.pop_front();
+
+        decoding++;
+
+        SDL_mutexV(mutex);
+
+        SDL_Surface* surface = TextureResource::decodeImage(filename);
+
+        SDL_mutexP(mutex);
+
+        decoded.push_back(RAvatarImage(filename, surface));
+        decoding--;
+
+        SDL_CondBroadcast(decoded_cond);
+    }
+
+    SDL_mutexV(mutex);
+}
+
+void RAvatarLoader::request(RUser* user, const std::string& filename) {
+
+    std::vector<RUser*>& users = waiting[filename];
+
+    users.push_back(user);
+
+    // already requested for another user
+    if(users.size() > 1) return;
+
+    SDL_mutexP(mutex);
+
+        requests.push_back(filename);
+
+        SDL_CondSignal(cond);
+
+    SDL_mutexV(mutex);
+}
+
+void RAvatarLoader::cancel(RUser* user) {
+
+    for(std::map<std::string, std::vector<RUser*> >::iterator it = waiting.begin(); it != waiting.end(); ) {
+        std::vector<RUser*>& users = it->second;
+
+        users.erase(std::remove(users.begin(), users.end(), user), users.end());
+
+        // the image is discarded when it arrives
+        if(users.empty()) {
+            waiting.erase(it++);
+            continue;
+        }
+
+        it++;
+    }
+}
+
+void RAvatarLoader::clear() {
+
+    SDL_mutexP(mutex);
+
+        requests.clear();
+
+        for(std::deque<RAvatarImage>::iterator it = decoded.begin(); it != decoded.end(); it++) {
+            if(it->surface != 0) SDL_FreeSurface(it->surface);
+        }
+
+        decoded.clear();
+
+    SDL_mutexV(mutex);
+
+    waiting.clear();
+}
+
+bool RAvatarLoader::takeDecoded(RAvatarImage& image) {
+
+    // decode here if there are no workers
+    if(threads.empty()) {
+        if(requests.empty()) return false;
+
+        image.filename = requests.front();
+        image.surface  = TextureResource::decodeImage(image.filename);
+
+        requests.pop_front();
+
+        return true;
+    }
+
+    bool found = false;
+
+    SDL_mutexP(mutex);
+
+        if(!decoded.empty()) {
+            image = decoded.front();
+            decoded.pop_front();
+            found = true;
+        }
+
+    SDL_mutexV(mutex);
+
+    return found;
+}
+
+void RAvatarLoader::assign(RAvatarImage& image) {
+
+    std::map<std::string, std::vector<RUser*> >::iterator it = waiting.find(image.filename);
+
+    if(it != waiting.end()) {
+
+        TextureResource* graphic = 0;
+
+        if(image.surface != 0) {
+            graphic = texturemanager.grabSurface(image.filename, image.surface, true, GL_CLAMP_TO_EDGE);
+        }
+
+        if(graphic == 0) {
+            debugLog("failed to load user image %s", image.filename.c_str());
+        }
+
+        std::vector<RUser*>& users = it->second;
+
+        for(size_t i=0;i<users.size();i++) {
+            // each user holds a reference
+            if(graphic != 0 && i > 0) graphic->addref();
+
+            users[i]->setUserImage(graphic);
+        }
+
+        waiting.erase(it);
+    }
+
+    if(image.surface != 0) SDL_FreeSurface(image.surface);
+    image.surface = 0;
+}
+
+void RAvatarLoader::upload(int budget) {
+
+    for(int i=0; budget < 0 || i < budget; i++) {
+
+        RAvatarImage image;
+
+        if(!takeDecoded(image)) break;
+
+        assign(image);
+    }
+}
+
+void RAvatarLoader::finish() {
+
+    if(waiting.empty()) return;
+
+    if(!threads.empty()) {
+        SDL_mutexP(mutex);
+
+            while(!requests.empty() || decoding > 0) {
+                SDL_CondWait(decoded_cond, mutex);
+            }
+
+        SDL_mutexV(mutex);
+    }
+
+    upload(-1);
+}
@@ -0,0 +1,70 @@
+// === File: src/avatars.h =====================================================
+// AGENT: PURPOSE    — Loading of user images off the render thread
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef RAVATARS_H
+#define RAVATARS_H
+
+#include "SDL_thread.h"
+
+#include "core/texture.h"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// textures created from decoded images per frame
+#define GOURCE_AVATAR_UPLOADS_PER_FRAME 2
+
+class RUser;
+
+class RAvatarImage {
+public:
+    RAvatarImage() : surface(0) {};
+    RAvatarImage(const std::string& filename, SDL_Surface* surface) : filename(filename), surface(surface) {};
+
+    std::string filename;
+    SDL_Surface* surface;
+};
+
+// user images are decoded by worker threads while users are drawn with the
+// default image. a limited number of decoded images are made into textures
+// each frame and given to the users waiting for them. if no threads can be
+// started (eg a build without thread support) images are decoded in upload().
+
+class RAvatarLoader {
+    std::vector<SDL_Thread*> threads;
+    SDL_mutex* mutex;
+    SDL_cond* cond;
+    SDL_cond* decoded_cond;
+
+    bool exiting;
+    int decoding;
+
+    std::deque<std::string> requests;
+    std::deque<RAvatarImage> decoded;
+
+    std::map<std::string, std::vector<RUser*> > waiting;
+
+    bool takeDecoded(RAvatarImage& image);
+    void assign(RAvatarImage& image);
+public:
+    RAvatarLoader(int workers = 2);
+    ~RAvatarLoader();
+
+    void request(RUser* user, const std::string& filename);
+    void cancel(RUser* user);
+    void clear();
+
+    // create up to budget textures from decoded images, or all if budget < 0
+    void upload(int budget);
+
+    // wait for and upload every requested image
+    void finish();
+
+    void decodeThread();
+};
+
+#endif
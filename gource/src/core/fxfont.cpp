@@ -54,6 +54,8 @@
 #include "fxfont.h"
 #include "renderer.h"
 
+#include <algorithm>
+
 FXFontManager fontmanager;
 
 //FxGlyph
@@ -94,6 +96,7 @@ FXGlyph::FXGlyph(FXGlyphSet* set, unsigned int chr) {
 
     //call_list = 0;
     page = 0;
+    sdf_glyph = 0;
 }
 
 FXGlyph::~FXGlyph() {
@@ -152,44 +155,89 @@ FXGlyphPage::FXGlyphPage(int page_width, int page_height) {
     memset(texture_data, 0, page_width * page_height);
 
     needs_update = false;
-    texture = 0;
+
+    dirty_x1 = dirty_y1 = dirty_x2 = dirty_y2 = 0;
+
+    // Use GL_RED for single-channel textures (WebGL 2 / OpenGL ES 3.0 doesn't support GL_ALPHA)
+    // The text shader reads from .r channel directly
+    texture = texturemanager.create(page_width, page_height, false, GL_CLAMP_TO_EDGE, GL_RED, texture_data);
 
     max_glyph_height = cursor_x = cursor_y = 1;
 }
 
 FXGlyphPage::~FXGlyphPage() {
+    if(needs_update) fontmanager.removeDirtyPage(this);
     delete[] texture_data;
 }
 
-bool FXGlyphPage::addGlyph(FXGlyph* glyph) {
+// largest page size supported, only queried once
+static int fx_glyph_page_size() {
+    static GLint page_size = 0;
 
-    FT_BitmapGlyph bitmap = glyph->glyph_bitmap;
+    if(!page_size) {
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &page_size);
+        page_size = glm::min( FX_GLYPH_PAGE_SIZE, page_size );
+    }
 
-    int corner_x = cursor_x;
-    int corner_y = cursor_y;
+    return page_size;
+}
+
+// copy a bitmap to the next free space on the page
+bool FXGlyphPage::addBitmap(const GLubyte* bitmap, int width, int height, int pitch, int& corner_x, int& corner_y) {
+
+    corner_x = cursor_x;
+    corner_y = cursor_y;
 
     int padding = 3;
 
-    if(bitmap->bitmap.rows > max_glyph_height) max_glyph_height = bitmap->bitmap.rows;
+    if(height > max_glyph_height) max_glyph_height = height;
 
-    if(corner_x + bitmap->bitmap.width + padding > page_width) {
+    if(corner_x + width + padding > page_width) {
         corner_x = 1;
         corner_y += max_glyph_height + padding;
 
         //bitmap is bigger than the full dimension
-        if(corner_x + bitmap->bitmap.width + padding > page_width) return false;
+        if(corner_x + width + padding > page_width) return false;
     }
 
-    if(corner_y + bitmap->bitmap.rows + padding > page_height) return false;
+    if(corner_y + height + padding > page_height) return false;
 
-    needs_update = true;
+    if(!needs_update) {
+        dirty_x1 = corner_x;
+        dirty_y1 = corner_y;
+        dirty_x2 = corner_x + width;
+        dirty_y2 = corner_y + height;
+
+        needs_update = true;
+        fontmanager.addDirtyPage(this);
+    } else {
+        dirty_x1 = glm::min(dirty_x1, corner_x);
+        dirty_y1 = glm::min(dirty_y1, corner_y);
+        dirty_x2 = glm::max(dirty_x2, corner_x + width);
+        dirty_y2 = glm::max(dirty_y2, corner_y + height);
+    }
 
-    for(int j=0; j < bitmap->bitmap.rows;j++) {
-        for(int i=0; i < bitmap->bitmap.width; i++) {
-            texture_data[(corner_x+i+(j+corner_y)*page_width)] = bitmap->bitmap.buffer[i + bitmap->bitmap.width*j];
+    for(int j=0; j < height;j++) {
+        for(int i=0; i < width; i++) {
+            texture_data[(corner_x+i+(j+corner_y)*page_width)] = bitmap[i + pitch*j];
         }
     }
 
+    // move cursor for next character
+    cursor_x = corner_x + width + padding;
+    cursor_y = corner_y;
+
+    return true;
+}
+
+bool FXGlyphPage::addGlyph(FXGlyph* glyph) {
+
+    FT_BitmapGlyph bitmap = glyph->glyph_bitmap;
+
+    int corner_x, corner_y;
+
+    if(!addBitmap(bitmap->bitmap.buffer, bitmap->bitmap.width, bitmap->bitmap.rows, bitmap->bitmap.width, corner_x, corner_y)) return false;
+
     //fprintf(stderr, "corner_x = %d, corner_y = %d\n", corner_x, corner_y);
 
     vec4 texcoords = vec4( (((float)corner_x)-0.5f) / (float) page_width,
@@ -201,30 +249,190 @@ bool FXGlyphPage::addGlyph(FXGlyph* glyph) {
 
     //glyph->compile(this, texcoords);
 
-    // move cursor for next character
-    cursor_x = corner_x + bitmap->bitmap.width + padding;
-    cursor_y = corner_y;
-
     return true;
 }
 
 void FXGlyphPage::updateTexture() {
     if(!needs_update) return;
 
-    if(!texture) {
-        // Use GL_RED for single-channel textures (WebGL 2 / OpenGL ES 3.0 doesn't support GL_ALPHA)
-        // The text shader reads from .r channel directly
-        texture = texturemanager.create(page_width, page_height, false, GL_CLAMP_TO_EDGE, GL_RED, texture_data);
-    } else {
-        texture->reload();
-    }
+    texture->reloadRegion(dirty_x1, dirty_y1, dirty_x2 - dirty_x1, dirty_y2 - dirty_y1);
 
     needs_update = false;
 }
 
+//FXSDFAtlas
+
+#define FX_SDF_FAR 1e20f
+
+// squared distance to the nearest zero of a sampled function, in place
+// (Felzenszwalb and Huttenlocher's lower envelope of parabolas)
+static void fx_sdf_transform(float* f, int n, int stride, std::vector<float>& d, std::vector<int>& v, std::vector<float>& z) {
+
+    int k = 0;
+    v[0] = 0;
+    z[0] = -FX_SDF_FAR;
+    z[1] =  FX_SDF_FAR;
+
+    for(int q = 1; q < n; q++) {
+        float fq = f[q*stride] + (float) (q*q);
+
+        int p = v[k];
+        float s = (fq - (f[p*stride] + (float) (p*p))) / (float) (2*q - 2*p);
+
+        while(s <= z[k]) {
+            k--;
+            p = v[k];
+            s = (fq - (f[p*stride] + (float) (p*p))) / (float) (2*q - 2*p);
+        }
+
+        k++;
+        v[k]   = q;
+        z[k]   = s;
+        z[k+1] = FX_SDF_FAR;
+    }
+
+    k = 0;
+
+    for(int q = 0; q < n; q++) {
+        while(z[k+1] < (float) q) k++;
+
+        int p = v[k];
+        d[q] = (float) ((q-p)*(q-p)) + f[p*stride];
+    }
+
+    for(int q = 0; q < n; q++) {
+        f[q*stride] = d[q];
+    }
+}
+
+static void fx_sdf_transform(std::vector<float>& grid, int width, int height) {
+
+    int n = std::max(width, height);
+
+    std::vector<float> d(n);
+    std::vector<int>   v(n);
+    std::vector<float> z(n+1);
+
+    for(int x = 0; x < width; x++) {
+        fx_sdf_transform(&(grid[x]), height, width, d, v, z);
+    }
+
+    for(int y = 0; y < height; y++) {
+        fx_sdf_transform(&(grid[y*width]), width, 1, d, v, z);
+    }
+}
+
+FXSDFAtlas::FXSDFAtlas(FT_Library freetype, const std::string& fontfile) {
+    this->fontfile = fontfile;
+
+    if(FT_New_Face(freetype, fontfile.c_str(), 0, &ft_face)) {
+        throw FXFontException(fontfile);
+    }
+
+    FT_Set_Pixel_Sizes(ft_face, 0, FX_SDF_SIZE);
+}
+
+FXSDFAtlas::~FXSDFAtlas() {
+    if(ft_face!=0) FT_Done_Face(ft_face);
+
+    for(std::vector<FXGlyphPage*>::iterator it = pages.begin(); it != pages.end(); it++) {
+        delete (*it);
+    }
+    pages.clear();
+
+    for(auto it: glyphs) {
+        delete it.second;
+    }
+    glyphs.clear();
+}
+
+// rasterise a glyph at FX_SDF_SIZE and store the signed distance to its
+// outline, with 0.5 on the outline and 1.0 FX_SDF_SPREAD pixels inside it
+
+const FXSDFGlyph* FXSDFAtlas::getGlyph(unsigned int chr) {
+    std::map<unsigned int, FXSDFGlyph*>::iterator it;
+
+    if((it = glyphs.find(chr)) != glyphs.end()) return it->second;
+
+    FXSDFGlyph* glyph = new FXSDFGlyph();
+    glyphs[chr] = glyph;
+
+    if(FT_Load_Char(ft_face, chr, FT_LOAD_RENDER)) return glyph;
+
+    const FT_Bitmap& bitmap = ft_face->glyph->bitmap;
+
+    //nothing to draw (eg space)
+    if(bitmap.width == 0 || bitmap.rows == 0) return glyph;
+
+    int spread = FX_SDF_SPREAD;
+    int width  = bitmap.width + spread * 2;
+    int height = bitmap.rows  + spread * 2;
+
+    std::vector<float> outside(width * height, FX_SDF_FAR);
+    std::vector<float> inside(width * height, 0.0f);
+
+    for(int y = 0; y < bitmap.rows; y++) {
+        for(int x = 0; x < bitmap.width; x++) {
+            if(bitmap.buffer[x + y * bitmap.pitch] < 128) continue;
+
+            int i = (x + spread) + (y + spread) * width;
+
+            outside[i] = 0.0f;
+            inside[i]  = FX_SDF_FAR;
+        }
+    }
+
+    fx_sdf_transform(outside, width, height);
+    fx_sdf_transform(inside,  width, height);
+
+    std::vector<GLubyte> field(width * height);
+
+    for(int i = 0; i < width * height; i++) {
+        // edges lie half way between pixel centres
+        float distance = outside[i] > 0.0f ? sqrtf(outside[i]) - 0.5f : 0.5f - sqrtf(inside[i]);
+
+        float value = glm::clamp(0.5f - distance / (2.0f * spread), 0.0f, 1.0f);
+
+        field[i] = (GLubyte) (value * 255.0f + 0.5f);
+    }
+
+    glyph->corner = vec2(ft_face->glyph->bitmap_left - spread, -ft_face->glyph->bitmap_top - spread);
+    glyph->dims   = vec2(width, height);
+
+    addToPage(glyph, &(field[0]), width, height);
+
+    return glyph;
+}
+
+void FXSDFAtlas::addToPage(FXSDFGlyph* glyph, const GLubyte* field, int width, int height) {
+
+    FXGlyphPage* page = pages.empty() ? 0 : pages.back();
+
+    int corner_x, corner_y;
+
+    if(page == 0 || !page->addBitmap(field, width, height, width, corner_x, corner_y)) {
+
+        int page_size = fx_glyph_page_size();
+
+        page = new FXGlyphPage(page_size, page_size);
+
+        pages.push_back(page);
+
+        if(!page->addBitmap(field, width, height, width, corner_x, corner_y)) {
+            throw FXFontException(fontfile);
+        }
+    }
+
+    glyph->page      = page;
+    glyph->texcoords = vec4( (float) corner_x / (float) page->getWidth(),
+                             (float) corner_y / (float) page->getHeight(),
+                             (float) (corner_x + width)  / (float) page->getWidth(),
+                             (float) (corner_y + height) / (float) page->getHeight() );
+}
+
 //FXGlyphSet
 
-FXGlyphSet::FXGlyphSet(FT_Library freetype, const std::string& fontfile, int size, int dpi, FT_Int32 ft_flags) {
+FXGlyphSet::FXGlyphSet(FT_Library freetype, const std::string& fontfile, int size, int dpi, FT_Int32 ft_flags, FXSDFAtlas* sdf_atlas) {
     this->freetype = freetype;
     this->fontfile = fontfile;
     this->size     = size;
@@ -235,6 +443,9 @@ FXGlyphSet::FXGlyphSet(FT_Library freetype, const std::string& fontfile, int siz
     this->tab_width  = 4.0f;
     this->max_height = 0;
 
+    this->sdf_atlas = sdf_atlas;
+    this->sdf_scale = (size * dpi / 72.0f) / (float) FX_SDF_SIZE;
+
     init();
 }
 
@@ -275,20 +486,10 @@ void FXGlyphSet::precache(const std::string& chars) {
 
     unsigned int chr;
 
-    //add to bitmap without updating textures until the end
-    pre_caching = true;
-
     while (*precache_glyphs) {
         chr  = *precache_glyphs++;
         getGlyph(chr);
     }
-
-    pre_caching = false;
-
-    for(std::vector<FXGlyphPage*>::iterator it = pages.begin(); it != pages.end(); it++) {
-        (*it)->updateTexture();
-    }
-
 }
 
 FXGlyph* FXGlyphSet::getGlyph(unsigned int chr) {
@@ -300,7 +501,32 @@ FXGlyph* FXGlyphSet::getGlyph(unsigned int chr) {
 
     FXGlyph* glyph = new FXGlyph(this, chr);
 
-    // paint glyph to next page it will fit on
+    max_height = glm::max( glyph->getHeight(), max_height );
+
+    //buffered text is drawn from the shared atlas, so only
+    //add glyphs to this set's pages when drawn directly
+    if(sdf_atlas != 0) {
+        glyph->sdf_glyph = sdf_atlas->getGlyph(chr);
+    } else {
+        addToPage(glyph);
+    }
+
+    glyphs[chr] = glyph;
+
+    return glyph;
+}
+
+FXGlyph* FXGlyphSet::getPagedGlyph(unsigned int chr) {
+
+    FXGlyph* glyph = getGlyph(chr);
+
+    if(glyph->page == 0) addToPage(glyph);
+
+    return glyph;
+}
+
+// paint glyph to next page it will fit on
+void FXGlyphSet::addToPage(FXGlyph* glyph) {
 
     FXGlyphPage* page = 0;
 
@@ -309,12 +535,9 @@ FXGlyph* FXGlyphSet::getGlyph(unsigned int chr) {
     //page is full, create new page
     if(page == 0 || !page->addGlyph(glyph)) {
 
-        //allocate page using maximum allowed texture size
-        GLint max_texture_size;
-        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
-        max_texture_size = glm::min( 512, max_texture_size );
+        int page_size = fx_glyph_page_size();
 
-        page = new FXGlyphPage(max_texture_size, max_texture_size);
+        page = new FXGlyphPage(page_size, page_size);
 
         pages.push_back(page);
 
@@ -322,15 +545,6 @@ FXGlyph* FXGlyphSet::getGlyph(unsigned int chr) {
             throw FXFontException(glyph->set->getFTFace()->family_name);
         }
     }
-
-    max_height = glm::max( glyph->getHeight(), max_height );
-
-    //update the texture unless this is the precaching process
-    if(!pre_caching) page->updateTexture();
-
-    glyphs[chr] = glyph;
-
-    return glyph;
 }
 
 float FXGlyphSet::getMaxWidth() const {
@@ -349,35 +563,62 @@ float FXGlyphSet::getDescender() const {
     return getFTFace()->descender * unit_scale.y;
 }
 
-float FXGlyphSet::getWidth(const std::string& text) {
+const FXTextRun& FXGlyphSet::getTextRun(const std::string& text) {
+
+    std::unordered_map<std::string, FXTextRun>::iterator it = text_runs.find(text);
+
+    if(it != text_runs.end()) return it->second;
+
+    if(text_runs.size() >= FX_TEXT_RUN_CACHE_SIZE) text_runs.clear();
+
+    FXTextRun& run = text_runs[text];
 
     FTUnicodeStringItr<unsigned char> unicode_text((const unsigned char*)text.c_str());
 
-    float width = 0.0;
     unsigned int chr;
 
     while (*unicode_text) {
         chr = *unicode_text++;
 
         FXGlyph* glyph = getGlyph(chr);
-        width += glyph->getAdvance().x;
+
+        run.glyphs.push_back(glyph);
+        run.positions.push_back(run.advance);
+
+        run.advance += glyph->getAdvance();
     }
 
-    return width;
+    return run;
+}
+
+float FXGlyphSet::getWidth(const std::string& text) {
+    return getTextRun(text).advance.x;
 }
 
 void FXGlyphSet::drawToVBO(vec2& cursor, const std::string& text, const vec4& colour) {
-    FTUnicodeStringItr<unsigned char> unicode_text((const unsigned char*)text.c_str());
 
-    unsigned int chr;
+    const FXTextRun& run = getTextRun(text);
 
-    while (*unicode_text) {
-        chr = *unicode_text++;
+    quadbuf& buffer = fontmanager.font_vbo;
 
-        FXGlyph* glyph = getGlyph(chr);
-        glyph->drawToVBO(fontmanager.font_vbo, cursor, colour);
-        cursor += glyph->getAdvance();
+    size_t glyph_count = run.glyphs.size();
+
+    if(sdf_atlas != 0) {
+        for(size_t i=0; i<glyph_count; i++) {
+            const FXSDFGlyph* sdf_glyph = run.glyphs[i]->sdf_glyph;
+
+            if(sdf_glyph->page == 0) continue;
+
+            buffer.add(sdf_glyph->page->texture->textureid, cursor + run.positions[i] + sdf_glyph->corner * sdf_scale, sdf_glyph->dims * sdf_scale, colour, sdf_glyph->texcoords);
+        }
+    } else {
+        for(size_t i=0; i<glyph_count; i++) {
+            const FXGlyph* glyph = run.glyphs[i];
+            buffer.add(glyph->page->texture->textureid, cursor + run.positions[i] + glyph->getCorner(), glyph->getDimensions(), colour, glyph->texcoords);
+        }
     }
+
+    cursor += run.advance;
 }
 
 void FXGlyphSet::draw(const std::string& text) {
@@ -405,11 +646,13 @@ void FXGlyphSet::draw(const std::string& text) {
              pos += glyph->getAdvance() * tab_width;
              continue;
         }
-        FXGlyph* glyph = getGlyph(chr);
+        FXGlyph* glyph = getPagedGlyph(chr);
 
         glyphs_to_draw.push_back(glyph);
     }
 
+    fontmanager.updatePages();
+
     for(auto glyph : glyphs_to_draw) {
         if(glyph->page->texture->textureid != textureid) {
             if(textureid != static_cast<GLuint>(-1)) r.end();
@@ -616,6 +859,7 @@ void FXFont::drawGlyphes() {
 // FXFontManager
 FXFontManager::FXFontManager() {
     library = 0;
+    use_sdf = false;
 }
 
 void FXFontManager::init() {
@@ -636,7 +880,27 @@ void FXFontManager::startBuffer() {
     use_vbo = true;
 }
 
+void FXFontManager::addDirtyPage(FXGlyphPage* page) {
+    dirty_pages.push_back(page);
+}
+
+void FXFontManager::removeDirtyPage(FXGlyphPage* page) {
+    dirty_pages.erase(std::remove(dirty_pages.begin(), dirty_pages.end(), page), dirty_pages.end());
+}
+
+// upload glyphs added to pages since the last update
+void FXFontManager::updatePages() {
+    if(dirty_pages.empty()) return;
+
+    for(std::vector<FXGlyphPage*>::iterator it = dirty_pages.begin(); it != dirty_pages.end(); it++) {
+        (*it)->updateTexture();
+    }
+
+    dirty_pages.clear();
+}
+
 void FXFontManager::commitBuffer() {
+    updatePages();
     font_vbo.update();
     use_vbo = false;
 }
@@ -666,6 +930,12 @@ void FXFontManager::purge() {
     }
 
     fonts.clear();
+
+    for(std::map<std::string,FXSDFAtlas*>::iterator it = sdf_atlases.begin(); it!=sdf_atlases.end();it++) {
+        delete it->second;
+    }
+
+    sdf_atlases.clear();
 }
 
 FXFont FXFontManager::grab(std::string font_file, int size, int dpi, FT_Int32 ft_flags) {
@@ -688,7 +958,17 @@ FXFont FXFontManager::grab(std::string font_file, int size, int dpi, FT_Int32 ft
     FXGlyphSet* glyphset;
 
     if(ft_it == sizemap->end()) {
-        glyphset = new FXGlyphSet(library, font_file.c_str(), size, dpi, ft_flags);
+        FXSDFAtlas* sdf_atlas = 0;
+
+        if(use_sdf) {
+            sdf_atlas = sdf_atlases[font_file];
+
+            if(!sdf_atlas) {
+                sdf_atlas = sdf_atlases[font_file] = new FXSDFAtlas(library, font_file);
+            }
+        }
+
+        glyphset = new FXGlyphSet(library, font_file.c_str(), size, dpi, ft_flags, sdf_atlas);
         sizemap->insert(std::pair<int,FXGlyphSet*>(size,glyphset));
     } else {
         glyphset = ft_it->second;
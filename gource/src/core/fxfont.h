@@ -64,6 +64,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -78,20 +79,35 @@ public:
 
 class FXGlyph;
 class FXGlyphSet;
+class FXSDFGlyph;
+
+// glyph pages are allocated at this size, or the maximum texture size if smaller
+#define FX_GLYPH_PAGE_SIZE 1024
+
+// bitmaps added to a page are uploaded with the rest of the page's dirty
+// region when the font manager next updates pages, at most once a frame
 
 class FXGlyphPage {
     GLubyte* texture_data;
     bool     needs_update;
     int      page_width;
     int      page_height;
+
+    int dirty_x1, dirty_y1;
+    int dirty_x2, dirty_y2;
 public:
     TextureResource* texture;
 
     FXGlyphPage(int page_width, int page_height);
     ~FXGlyphPage();
 
+    int getWidth() const  { return page_width; };
+    int getHeight() const { return page_height; };
+
+    bool addBitmap(const GLubyte* bitmap, int width, int height, int pitch, int& corner_x, int& corner_y);
     bool addGlyph(FXGlyph* glyph);
 
+    bool needsUpdate() const { return needs_update; };
     void updateTexture();
 
     int cursor_x, cursor_y;
@@ -112,6 +128,7 @@ public:
     FXGlyphPage* page;
     vec4 texcoords;
     FXGlyphSet* set;
+    const FXSDFGlyph* sdf_glyph;
     FT_Glyph       ftglyph;
     FT_BitmapGlyph glyph_bitmap;
 
@@ -130,6 +147,54 @@ public:
     void draw(const vec2& pos) const;
 };
 
+// signed distance field glyphs are rasterised once per font file at this
+// pixel size and scaled to the size of each glyph set when drawn.
+// the field covers FX_SDF_SPREAD pixels either side of the outline.
+#define FX_SDF_SIZE   48
+#define FX_SDF_SPREAD 6
+
+class FXSDFGlyph {
+public:
+    FXGlyphPage* page;
+    vec2 corner;
+    vec2 dims;
+    vec4 texcoords;
+
+    FXSDFGlyph() : page(0), corner(0.0f, 0.0f), dims(0.0f, 0.0f), texcoords(0.0f) {};
+};
+
+// distance field glyphs of one font file shared by glyph sets of every size
+
+class FXSDFAtlas {
+    FT_Face ft_face;
+    std::string fontfile;
+
+    std::vector<FXGlyphPage*> pages;
+    std::map<unsigned int, FXSDFGlyph*> glyphs;
+
+    void addToPage(FXSDFGlyph* glyph, const GLubyte* field, int width, int height);
+public:
+    FXSDFAtlas(FT_Library freetype, const std::string& fontfile);
+    ~FXSDFAtlas();
+
+    const FXSDFGlyph* getGlyph(unsigned int chr);
+};
+
+// glyphs of a string and their pen positions, so a label drawn every
+// frame is not decoded and looked up a character at a time
+
+class FXTextRun {
+public:
+    std::vector<const FXGlyph*> glyphs;
+    std::vector<vec2> positions;
+    vec2 advance;
+
+    FXTextRun() : advance(0.0f, 0.0f) {};
+};
+
+// cleared when full rather than tracking usage
+#define FX_TEXT_RUN_CACHE_SIZE 65536
+
 class FXGlyphSet {
     FT_Library freetype;
     FT_Face ft_face;
@@ -140,16 +205,23 @@ class FXGlyphSet {
     int dpi;
     float tab_width;
     vec2 unit_scale;
-    bool pre_caching;
+
+    FXSDFAtlas* sdf_atlas;
+    float sdf_scale;
 
     std::vector<FXGlyphPage*> pages;
 
     std::map<unsigned int, FXGlyph*> glyphs;
 
+    std::unordered_map<std::string, FXTextRun> text_runs;
+
     void init();
     FXGlyph* getGlyph(unsigned int chr);
+    FXGlyph* getPagedGlyph(unsigned int chr);
+    void addToPage(FXGlyph* glyph);
+    const FXTextRun& getTextRun(const std::string& text);
 public:
-    FXGlyphSet(FT_Library freetype, const std::string& fontfile, int size, int dpi, FT_Int32 ft_flags);
+    FXGlyphSet(FT_Library freetype, const std::string& fontfile, int size, int dpi, FT_Int32 ft_flags, FXSDFAtlas* sdf_atlas = 0);
     ~FXGlyphSet();
 
     void precache(const std::string& chars);
@@ -238,13 +310,19 @@ class FXFontManager {
     std::string font_dir;
 
     std::map<std::string, fontSizeMap*> fonts;
+    std::map<std::string, FXSDFAtlas*> sdf_atlases;
     FT_Library library;
+
+    std::vector<FXGlyphPage*> dirty_pages;
 public:
     quadbuf font_vbo;
 
     FXFontManager();
     bool use_vbo;
 
+    // buffered text of fonts grabbed while set is drawn from distance field atlases
+    bool use_sdf;
+
     void setDir(std::string font_dir);
     void init();
 
@@ -254,6 +332,10 @@ public:
     void destroy();
     void purge();
 
+    void addDirtyPage(FXGlyphPage* page);
+    void removeDirtyPage(FXGlyphPage* page);
+    void updatePages();
+
     void startBuffer();
     void commitBuffer();
     void drawBuffer();
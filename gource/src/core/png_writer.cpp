@@ -29,6 +29,7 @@
 #include "display.h"
 
 #include <iostream>
+#include <cstdio>
 
 #define PNG_SKIP_SETJMP_CHECK
 #include <png.h>
@@ -36,6 +37,33 @@
 PNGWriter::PNGWriter(int components)
     : components(components) {
     out = 0;
+    compression_level = PNG_WRITER_DEFAULT_COMPRESSION;
+    filters           = PNG_WRITER_DEFAULT_FILTERS;
+
+    row_png    = 0;
+    row_info   = 0;
+    row_width  = 0;
+    row_height = 0;
+    row_failed = false;
+}
+
+void PNGWriter::setCompression(int compression_level, int filters) {
+    this->compression_level = compression_level;
+    this->filters           = filters;
+}
+
+bool PNGWriter::parseFilters(const std::string& name, int& filters) {
+
+    if(name == "default")    filters = PNG_WRITER_DEFAULT_FILTERS;
+    else if(name == "none")  filters = PNG_FILTER_NONE;
+    else if(name == "sub")   filters = PNG_FILTER_SUB;
+    else if(name == "up")    filters = PNG_FILTER_UP;
+    else if(name == "avg")   filters = PNG_FILTER_AVG;
+    else if(name == "paeth") filters = PNG_FILTER_PAETH;
+    else if(name == "all")   filters = PNG_ALL_FILTERS;
+    else return false;
+
+    return true;
 }
 
 bool PNGWriter::open(const std::string& filename) {
@@ -52,7 +80,11 @@ bool PNGWriter::open(const std::string& filename) {
 }
 
 void PNGWriter::close() {
-    ((std::fstream*)out)->close();
+    if(out == 0) return;
+
+    ((std::ofstream*)out)->close();
+    delete out;
+    out = 0;
 }
 
 void PNGWriter::setOutputStream(std::ostream* out) {
@@ -89,6 +121,10 @@ void png_writer_flush_data(png_structp png_ptr) {
 }
 
 void PNGWriter::writePNG(std::vector<char>& buffer) {
+    writePNG(&(buffer[0]));
+}
+
+void PNGWriter::writePNG(const char* pixels) {
 
     png_structp png_ptr  = png_create_write_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0);
 
@@ -108,9 +144,17 @@ void PNGWriter::writePNG(std::vector<char>& buffer) {
 
     png_set_IHDR(png_ptr, info_ptr, display.width, display.height, 8, colour_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
+    if(compression_level != PNG_WRITER_DEFAULT_COMPRESSION) {
+        png_set_compression_level(png_ptr, compression_level);
+    }
+
+    if(filters != PNG_WRITER_DEFAULT_FILTERS) {
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filters);
+    }
+
     std::vector<png_bytep> rows(display.height);
     for (int i = 0; i < display.height; i++) {
-        rows[i] = (png_bytep) &(buffer[(display.height-i-1) * components * display.width]);
+        rows[i] = (png_bytep) (pixels + (display.height-i-1) * components * display.width);
     }
 
     png_write_info(png_ptr, info_ptr);
@@ -120,6 +164,89 @@ void PNGWriter::writePNG(std::vector<char>& buffer) {
     png_destroy_write_struct(&png_ptr, &info_ptr);
 }
 
+// write an image a row at a time. each call needs its own setjmp
+// as libpng jumps back to the most recent one on error
+
+bool PNGWriter::beginImage(int width, int height) {
+
+    if(out == 0) return false;
+
+    png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0);
+
+    if(!png_ptr) return false;
+
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+
+    if(!info_ptr) {
+        png_destroy_write_struct(&png_ptr, 0);
+        return false;
+    }
+
+    row_png    = png_ptr;
+    row_info   = info_ptr;
+    row_width  = width;
+    row_height = height;
+    row_failed = false;
+
+    if(setjmp(png_jmpbuf(png_ptr))) {
+        fprintf(stderr, "failed to write png header\n");
+        row_failed = true;
+        return true;
+    }
+
+    png_set_write_fn(png_ptr, out, png_writer_write_data, png_writer_flush_data);
+
+    int colour_type = (components == 4) ? PNG_COLOR_TYPE_RGB_ALPHA : PNG_COLOR_TYPE_RGB;
+
+    png_set_IHDR(png_ptr, info_ptr, width, height, 8, colour_type, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+
+    if(compression_level != PNG_WRITER_DEFAULT_COMPRESSION) {
+        png_set_compression_level(png_ptr, compression_level);
+    }
+
+    if(filters != PNG_WRITER_DEFAULT_FILTERS) {
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, filters);
+    }
+
+    png_write_info(png_ptr, info_ptr);
+
+    return true;
+}
+
+void PNGWriter::writeRows(const char* rows, int count) {
+    if(row_png == 0 || row_failed) return;
+
+    png_structp png_ptr = row_png;
+
+    if(setjmp(png_jmpbuf(png_ptr))) {
+        fprintf(stderr, "failed to write png rows\n");
+        row_failed = true;
+        return;
+    }
+
+    size_t stride = row_width * components;
+
+    for(int i=0;i<count;i++) {
+        png_write_row(png_ptr, (png_const_bytep) (rows + i * stride));
+    }
+}
+
+void PNGWriter::endImage() {
+    if(row_png == 0) return;
+
+    png_structp png_ptr  = row_png;
+    png_infop   info_ptr = row_info;
+
+    if(!row_failed && !setjmp(png_jmpbuf(png_ptr))) {
+        png_write_end(png_ptr, 0);
+    }
+
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+
+    row_png  = 0;
+    row_info = 0;
+}
+
 // PNGExporter
 
 PNGExporter::PNGExporter(const std::string& filename) {
@@ -227,3 +354,108 @@ void PNGExporter::capture() {
     SDL_CondSignal(cond);
     SDL_mutexV(mutex);
 }
+
+// PNGSequenceExporter
+
+PNGSequenceExporter::PNGSequenceExporter(const std::string& output, int workers, int compression_level, int filters)
+    : FrameExporter(workers), compression_level(compression_level), filters(filters) {
+
+    filename_pattern = filenamePattern(output);
+    tile_png = 0;
+
+    // fail now rather than from a worker if the frames cannot be written
+    char filename[1024];
+    frameFilename(0, filename, sizeof(filename));
+
+    std::ofstream test(filename, std::ios::out | std::ios::binary);
+
+    if(test.fail()) {
+        throw PNGExporterException(filename);
+    }
+
+    test.close();
+    remove(filename);
+}
+
+PNGSequenceExporter::~PNGSequenceExporter() {
+    //write remaining frames while this is still a PNGSequenceExporter
+    stop();
+}
+
+// a pattern containing a frame number format is used as is,
+// otherwise the output is treated as a directory
+
+std::string PNGSequenceExporter::filenamePattern(const std::string& output) {
+
+    if(output.find('%') != std::string::npos) return output;
+
+    std::string pattern = output;
+
+    if(!pattern.empty() && pattern[pattern.size()-1] != '/' && pattern[pattern.size()-1] != '\\') {
+        pattern += '/';
+    }
+
+    return pattern + "frame-%06d.png";
+}
+
+void PNGSequenceExporter::frameFilename(int frame_number, char* filename, size_t size) {
+    snprintf(filename, size, filename_pattern.c_str(), frame_number);
+}
+
+void PNGSequenceExporter::writeFrame(const char* frame, int frame_number) {
+
+    char filename[1024];
+    frameFilename(frame_number, filename, sizeof(filename));
+
+    // each worker uses its own writer. the frame is bottom-up, which writePNG expects
+    PNGWriter writer;
+    writer.setCompression(compression_level, filters);
+
+    if(!writer.open(filename)) {
+        fprintf(stderr, "failed to write frame %s\n", filename);
+        return;
+    }
+
+    try {
+        writer.writePNG(frame);
+    } catch(PNGExporterException& exception) {
+        fprintf(stderr, "failed to write frame %s: %s\n", filename, exception.what());
+    }
+
+    writer.close();
+}
+
+// tiled frames are written on the render thread and take the next frame number
+
+bool PNGSequenceExporter::beginImage(int width, int height) {
+
+    char filename[1024];
+    frameFilename(++frames_exported, filename, sizeof(filename));
+
+    tile_png = new PNGWriter();
+    tile_png->setCompression(compression_level, filters);
+
+    if(!tile_png->open(filename) || !tile_png->beginImage(width, height)) {
+        fprintf(stderr, "failed to write frame %s\n", filename);
+        tile_png->close();
+        delete tile_png;
+        tile_png = 0;
+        return false;
+    }
+
+    return true;
+}
+
+void PNGSequenceExporter::writeRows(const char* rows, int count) {
+    if(tile_png != 0) tile_png->writeRows(rows, count);
+}
+
+void PNGSequenceExporter::endImage() {
+    if(tile_png == 0) return;
+
+    tile_png->endImage();
+    tile_png->close();
+
+    delete tile_png;
+    tile_png = 0;
+}
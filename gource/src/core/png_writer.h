@@ -29,19 +29,41 @@
 #define PNG_WRITER_H
 
 #include "SDL_thread.h"
+#include "ppm.h"
+#include "tiled_render.h"
 
 #include <fstream>
 #include <vector>
 
-class PNGWriter {
+// libpng defaults, resolved per row by libpng
+#define PNG_WRITER_DEFAULT_COMPRESSION -1
+#define PNG_WRITER_DEFAULT_FILTERS     -1
+
+struct png_struct_def;
+struct png_info_def;
+
+class PNGWriter : public TileRowWriter {
 protected:
     std::ostream* out;
     size_t components;
 
+    int compression_level;
+    int filters;
+
+    // image being written a row at a time
+    png_struct_def* row_png;
+    png_info_def*   row_info;
+    int row_width, row_height;
+    bool row_failed;
+
     void init();
 public:
     PNGWriter(int components = 3);
 
+    void setCompression(int compression_level, int filters);
+
+    static bool parseFilters(const std::string& name, int& filters);
+
     bool open(const std::string& filename);
     void close();
 
@@ -50,6 +72,12 @@ public:
     void screenshot(const std::string& filename);
     void capture(std::vector<char>& buffer);
     void writePNG(std::vector<char>& buffer);
+    void writePNG(const char* pixels);
+
+    int  getComponents() { return components; };
+    bool beginImage(int width, int height);
+    void writeRows(const char* rows, int count);
+    void endImage();
 };
 
 enum png_exporter_state { PNG_EXPORTER_WAIT, PNG_EXPORTER_WRITE, PNG_EXPORTER_EXIT, PNG_EXPORTER_STOPPED };
@@ -82,6 +110,34 @@ public:
     void capture();
 };
 
+// writes each frame to its own numbered PNG file. frames are compressed
+// by a pool of workers and may be written out of order
+
+class PNGSequenceExporter : public FrameExporter, public TileRowWriter {
+protected:
+    std::string filename_pattern;
+    int compression_level;
+    int filters;
+
+    PNGWriter* tile_png;
+
+    void frameFilename(int frame_number, char* filename, size_t size);
+
+public:
+    PNGSequenceExporter(const std::string& output, int workers, int compression_level = PNG_WRITER_DEFAULT_COMPRESSION, int filters = PNG_WRITER_DEFAULT_FILTERS);
+    virtual ~PNGSequenceExporter();
+
+    static std::string filenamePattern(const std::string& output);
+
+    virtual void writeFrame(const char* frame, int frame_number);
+
+    virtual TileRowWriter* getTileWriter() { return this; };
+
+    bool beginImage(int width, int height);
+    void writeRows(const char* rows, int count);
+    void endImage();
+};
+
 class PNGExporterException : public std::exception {
 protected:
     std::string filename;
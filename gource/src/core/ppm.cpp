@@ -19,6 +19,9 @@
 #include "display.h"
 #include "sdlapp.h"
 
+#include <cstring>
+#include <algorithm>
+
 #ifdef _WIN32
     #include <io.h>
     #include <fcntl.h>
@@ -36,30 +39,70 @@ static int dumper_thread(void *arg) {
 
 // FrameExporter
 
-FrameExporter::FrameExporter() {
+FrameExporter::FrameExporter(int workers) {
 
     //this now assumes the display is setup
     //before the frame exporter is created
     //(which seems reasonable)
 
     rowstride     = display.width * 3;
+    frame_size    = display.height * rowstride;
+
+    workers = std::max(1, workers);
+
+    // every worker can hold a frame while the queue is full
+    int frame_count = FRAME_EXPORTER_QUEUE_SIZE + workers - 1;
+
+    for(int i=0;i<frame_count;i++) {
+        char* frame = new char[frame_size];
+        frames.push_back(frame);
+        frames_free.push_back(frame);
+    }
+
+    pixels_out = new char[frame_size];
+
+    // read back through pixel buffers so glReadPixels returns without
+    // waiting for rendering to finish. WebGL cannot map buffers for reading.
+#ifdef __EMSCRIPTEN__
+    use_pixel_buffers = false;
+#else
+    use_pixel_buffers = true;
+#endif
 
-    pixels1        = new char[display.height * rowstride];
-    pixels2        = new char[display.height * rowstride];
-    pixels_out     = new char[display.height * rowstride];
+    pixel_buffer_index    = 0;
+    pixel_buffers_pending = 0;
 
-    pixels_shared_ptr = 0;
+    if(use_pixel_buffers) {
+        glGenBuffers(FRAME_EXPORTER_READBACK_DEPTH, pixel_buffers);
+
+        for(int i=0;i<FRAME_EXPORTER_READBACK_DEPTH;i++) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pixel_buffers[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, frame_size, 0, GL_STREAM_READ);
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    frames_exported = 0;
 
     dumper_thread_state = FRAME_EXPORTER_WAIT;
 
     cond   = SDL_CreateCond();
     mutex  = SDL_CreateMutex();
 
+    for(int i=0;i<workers;i++) {
 #if SDL_VERSION_ATLEAST(2,0,0)
-    thread = SDL_CreateThread( dumper_thread, "frame_exporter", this );
+        SDL_Thread* thread = SDL_CreateThread( dumper_thread, "frame_exporter", this );
 #else
-    thread = SDL_CreateThread( dumper_thread, this );
+        SDL_Thread* thread = SDL_CreateThread( dumper_thread, this );
 #endif
+        if(thread != 0) threads.push_back(thread);
+    }
+
+    // frames are written by queueFrame on the render thread if no worker started
+    if(threads.size() < (size_t) workers) {
+        fprintf(stderr, "started %d of %d frame exporter threads\n", (int) threads.size(), workers);
+    }
 }
 
 FrameExporter::~FrameExporter() {
@@ -68,29 +111,115 @@ FrameExporter::~FrameExporter() {
     SDL_DestroyCond(cond);
     SDL_DestroyMutex(mutex);
 
-    pixels_shared_ptr = 0;
+    if(use_pixel_buffers) {
+        glDeleteBuffers(FRAME_EXPORTER_READBACK_DEPTH, pixel_buffers);
+    }
+
+    for(size_t i=0;i<frames.size();i++) {
+        delete[] frames[i];
+    }
 
-    delete[] pixels1;
-    delete[] pixels2;
     delete[] pixels_out;
 }
 
 void FrameExporter::stop() {
-    if(!thread) return;
-    
     if(dumper_thread_state == FRAME_EXPORTER_STOPPED || dumper_thread_state == FRAME_EXPORTER_EXIT) return;
 
+    // queue frames still being read back
+    flush();
+
+    // frames were written as they were queued
+    if(threads.empty()) return;
+
     SDL_mutexP(mutex);
 
         dumper_thread_state = FRAME_EXPORTER_EXIT;
 
-        SDL_CondSignal(cond);
+        SDL_CondBroadcast(cond);
+
+    SDL_mutexV(mutex);
+
+    // the dumper threads write any queued frames before exiting
+    for(size_t i=0;i<threads.size();i++) {
+        SDL_WaitThread(threads[i], 0);
+    }
+
+    threads.clear();
+
+    dumper_thread_state = FRAME_EXPORTER_STOPPED;
+}
+
+// get a free frame, waiting for a dumper thread to finish
+// with one if they are all queued
+char* FrameExporter::acquireFrame() {
+
+    SDL_mutexP(mutex);
+
+        while(frames_free.empty()) {
+            SDL_CondWait(cond, mutex);
+        }
+
+        char* frame = frames_free.back();
+        frames_free.pop_back();
 
     SDL_mutexV(mutex);
 
-    SDL_WaitThread(thread, 0);
-    
-    thread = 0;
+    return frame;
+}
+
+void FrameExporter::queueFrame(char* frame) {
+
+    // without a dumper thread nothing would return the frame,
+    // so write it on the render thread
+    if(threads.empty()) {
+        writeFrame(frame, ++frames_exported);
+        frames_free.push_back(frame);
+        return;
+    }
+
+    SDL_mutexP(mutex);
+
+        FrameExporterFrame queued;
+        queued.pixels = frame;
+        queued.number = ++frames_exported;
+
+        frames_queued.push_back(queued);
+
+    SDL_CondBroadcast(cond);
+    SDL_mutexV(mutex);
+}
+
+// copy the oldest outstanding read out of its pixel buffer
+void FrameExporter::readPendingFrame() {
+
+    int index = (pixel_buffer_index + FRAME_EXPORTER_READBACK_DEPTH - pixel_buffers_pending) % FRAME_EXPORTER_READBACK_DEPTH;
+
+    char* frame = acquireFrame();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixel_buffers[index]);
+
+    void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frame_size, GL_MAP_READ_BIT);
+
+    if(data != 0) {
+        memcpy(frame, data, frame_size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        // still write the frame so the output keeps the correct timing
+        fprintf(stderr, "failed to map frame pixel buffer\n");
+        memset(frame, 0, frame_size);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    pixel_buffers_pending--;
+
+    queueFrame(frame);
+}
+
+void FrameExporter::flush() {
+    while(pixel_buffers_pending > 0) {
+        readPendingFrame();
+    }
 }
 
 void FrameExporter::dump() {
@@ -100,55 +229,76 @@ void FrameExporter::dump() {
     glEnable(GL_TEXTURE_2D);
     glDisable(GL_BLEND);
 
-    char* next_pixel_ptr = (pixels_shared_ptr == pixels1) ? pixels2 : pixels1;
-
-    // copy pixels - now the right way up
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glReadPixels(0, 0, display.width, display.height,
-        GL_RGB, GL_UNSIGNED_BYTE, next_pixel_ptr);
 
-    // wait for lock before changing the pointer to point to our new buffer
-    SDL_mutexP(mutex);
+    if(!use_pixel_buffers) {
+        char* frame = acquireFrame();
 
-        //flip buffer we are pointing at
-        pixels_shared_ptr = next_pixel_ptr;
-        dumper_thread_state = FRAME_EXPORTER_DUMP;
+        glReadPixels(0, 0, display.width, display.height,
+            GL_RGB, GL_UNSIGNED_BYTE, frame);
 
-    SDL_CondSignal(cond);
-    SDL_mutexV(mutex);
+        queueFrame(frame);
+        return;
+    }
+
+    // the next pixel buffer is still holding the oldest read
+    if(pixel_buffers_pending == FRAME_EXPORTER_READBACK_DEPTH) {
+        readPendingFrame();
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixel_buffers[pixel_buffer_index]);
+
+    glReadPixels(0, 0, display.width, display.height,
+        GL_RGB, GL_UNSIGNED_BYTE, 0);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    pixel_buffer_index = (pixel_buffer_index + 1) % FRAME_EXPORTER_READBACK_DEPTH;
+    pixel_buffers_pending++;
 }
 
 void FrameExporter::dumpThr() {
 
     SDL_mutexP(mutex);
 
-    while(dumper_thread_state != FRAME_EXPORTER_EXIT) {
-
-        dumper_thread_state = FRAME_EXPORTER_WAIT;
+    while(true) {
 
-        while (dumper_thread_state == FRAME_EXPORTER_WAIT) {
+        while (frames_queued.empty() && dumper_thread_state != FRAME_EXPORTER_EXIT) {
             SDL_CondWait(cond, mutex);
         }
 
-        if (dumper_thread_state == FRAME_EXPORTER_EXIT) break;
+        // only exit once all queued frames have been written
+        if (frames_queued.empty()) break;
 
-        if (pixels_shared_ptr != 0) {
+        FrameExporterFrame queued = frames_queued.front();
+        frames_queued.pop_front();
 
-            //invert image
-            for(int y=0;y<display.height;y++) {
-                for(int x=0;x<rowstride;x++) {
-                    pixels_out[x + y * rowstride] = pixels_shared_ptr[x + (display.height - y - 1) * rowstride];
-                }
-            }
+        if (dumper_thread_state == FRAME_EXPORTER_WAIT) dumper_thread_state = FRAME_EXPORTER_DUMP;
 
-            dumpImpl();
-        }
-    }
+        SDL_mutexV(mutex);
 
-    dumper_thread_state = FRAME_EXPORTER_STOPPED;
+        writeFrame(queued.pixels, queued.number);
+
+        SDL_mutexP(mutex);
+
+        frames_free.push_back(queued.pixels);
+
+        if (dumper_thread_state == FRAME_EXPORTER_DUMP) dumper_thread_state = FRAME_EXPORTER_WAIT;
+
+        SDL_CondBroadcast(cond);
+    }
 
     SDL_mutexV(mutex);
+}
+
+void FrameExporter::writeFrame(const char* frame, int frame_number) {
+
+    //invert image
+    for(int y=0;y<display.height;y++) {
+        memcpy(pixels_out + y * rowstride, frame + (display.height - y - 1) * rowstride, rowstride);
+    }
 
+    dumpImpl();
 }
 
 // PPMExporter
@@ -173,6 +323,8 @@ PPMExporter::PPMExporter(std::string outputfile) {
 
     //write header
     sprintf(ppmheader, "P6\n%d %d 255\n", display.width, display.height);
+
+    tile_row_size = 0;
 }
 
 PPMExporter::~PPMExporter() {
@@ -186,3 +338,102 @@ void PPMExporter::dumpImpl() {
     *output << ppmheader;
     output->write(pixels_out, rowstride * display.height);
 }
+
+// tiled frames are written directly from the render thread.
+// the dumper thread is idle as no frames are queued.
+
+bool PPMExporter::beginImage(int width, int height) {
+    char header[1024];
+    sprintf(header, "P6\n%d %d 255\n", width, height);
+
+    *output << header;
+
+    tile_row_size = width * 3;
+
+    return true;
+}
+
+void PPMExporter::writeRows(const char* rows, int count) {
+    output->write(rows, tile_row_size * count);
+}
+
+void PPMExporter::endImage() {
+}
+
+// Y4MExporter
+
+Y4MExporter::Y4MExporter(std::string outputfile, int framerate) : PPMExporter(outputfile) {
+
+    chroma_width  = (display.width  + 1) / 2;
+    chroma_height = (display.height + 1) / 2;
+
+    yuv_size   = display.width * display.height + chroma_width * chroma_height * 2;
+    yuv_pixels = new unsigned char[yuv_size];
+
+    header_written = false;
+
+    //4:2:0 with chroma sited at the centre of each 2x2 block
+    sprintf(y4mheader, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", display.width, display.height, framerate);
+}
+
+Y4MExporter::~Y4MExporter() {
+    //write remaining frames while this is still a Y4MExporter
+    stop();
+
+    delete[] yuv_pixels;
+}
+
+// convert the RGB frame to planar YUV 4:2:0 using BT.601 studio range.
+// each plane is produced by a simple loop over a row so the compiler can vectorize it.
+
+void Y4MExporter::convertFrame() {
+
+    const unsigned char* rgb = (const unsigned char*) pixels_out;
+
+    unsigned char* y_plane = yuv_pixels;
+    unsigned char* u_plane = y_plane + display.width * display.height;
+    unsigned char* v_plane = u_plane + chroma_width * chroma_height;
+
+    for(int y=0;y<display.height;y++) {
+        const unsigned char* row = rgb + y * rowstride;
+        unsigned char* out = y_plane + y * display.width;
+
+        for(int x=0;x<display.width;x++) {
+            int r = row[x*3], g = row[x*3+1], b = row[x*3+2];
+            out[x] = (unsigned char) (((66*r + 129*g + 25*b + 128) >> 8) + 16);
+        }
+    }
+
+    for(int cy=0;cy<chroma_height;cy++) {
+        const unsigned char* row1 = rgb + (cy*2) * rowstride;
+        const unsigned char* row2 = rgb + std::min(cy*2+1, display.height-1) * rowstride;
+
+        unsigned char* u_out = u_plane + cy * chroma_width;
+        unsigned char* v_out = v_plane + cy * chroma_width;
+
+        for(int cx=0;cx<chroma_width;cx++) {
+            int x1 = cx*2*3;
+            int x2 = std::min(cx*2+1, display.width-1)*3;
+
+            int r = (row1[x1]   + row1[x2]   + row2[x1]   + row2[x2]   + 2) >> 2;
+            int g = (row1[x1+1] + row1[x2+1] + row2[x1+1] + row2[x2+1] + 2) >> 2;
+            int b = (row1[x1+2] + row1[x2+2] + row2[x1+2] + row2[x2+2] + 2) >> 2;
+
+            u_out[cx] = (unsigned char) (((-38*r -  74*g + 112*b + 128) >> 8) + 128);
+            v_out[cx] = (unsigned char) (((112*r -  94*g -  18*b + 128) >> 8) + 128);
+        }
+    }
+}
+
+void Y4MExporter::dumpImpl() {
+
+    convertFrame();
+
+    if(!header_written) {
+        *output << y4mheader;
+        header_written = true;
+    }
+
+    *output << "FRAME\n";
+    output->write((const char*) yuv_pixels, yuv_size);
+}
@@ -23,40 +23,82 @@
 #include <ostream>
 #include <string>
 #include <exception>
+#include <vector>
+#include <deque>
 
 #include "SDL.h"
 #include "gl.h"
+#include "tiled_render.h"
 
 enum { FRAME_EXPORTER_WAIT,
        FRAME_EXPORTER_DUMP,
        FRAME_EXPORTER_EXIT,
        FRAME_EXPORTER_STOPPED };
 
+// number of pixel buffers frames are read back through. a frame is
+// copied out of its buffer when the buffer is next needed, giving the
+// GPU a couple of frames to complete the transfer
+#define FRAME_EXPORTER_READBACK_DEPTH 3
+
+// number of frames that can be waiting for the dumper threads before
+// the renderer is made to wait for them
+#define FRAME_EXPORTER_QUEUE_SIZE 4
+
+struct FrameExporterFrame {
+    char* pixels;
+    int   number;
+};
+
 class FrameExporter {
 protected:
 
-    char* pixels1;
-    char* pixels2;
-    char* pixels_out;
+    std::vector<char*> frames;
+    std::vector<char*> frames_free;
+    std::deque<FrameExporterFrame> frames_queued;
+
+    int frames_exported;
 
-    char* pixels_shared_ptr;
+    char* pixels_out;
 
     size_t rowstride;
+    size_t frame_size;
+
+    bool use_pixel_buffers;
+    GLuint pixel_buffers[FRAME_EXPORTER_READBACK_DEPTH];
+    int pixel_buffer_index;
+    int pixel_buffers_pending;
 
     GLuint screentex;
 
-    SDL_Thread* thread;
+    std::vector<SDL_Thread*> threads;
     SDL_mutex* mutex;
     SDL_cond* cond;
     int dumper_thread_state;
 
+    char* acquireFrame();
+    void queueFrame(char* frame);
+    void readPendingFrame();
+    void flush();
 public:
-    FrameExporter();
+    FrameExporter(int workers = 1);
     virtual ~FrameExporter();
     void stop();
     void dump();
     void dumpThr();
+
+    // count a frame exported elsewhere, keeping frame numbers in sequence
+    void skipFrame() { frames_exported++; };
+
+    // called by the dumper threads with a bottom-up frame. the default flips it
+    // into pixels_out and calls dumpImpl(), which is only safe with one worker
+    virtual void writeFrame(const char* frame, int frame_number);
     virtual void dumpImpl() {};
+
+    // writer for frames rendered in tiles, if the format supports it
+    virtual TileRowWriter* getTileWriter() { return 0; };
+
+    // continue the output of an earlier segment, for formats written as one stream
+    virtual void continueStream() {};
 };
 
 class PPMExporterException : public std::exception {
@@ -69,16 +111,49 @@ public:
     virtual const char* what() const throw() { return filename.c_str(); }
 };
 
-class PPMExporter : public FrameExporter {
+class PPMExporter : public FrameExporter, public TileRowWriter {
 protected:
     std::ostream* output;
     std::string filename;
     char ppmheader[1024];
 
+    size_t tile_row_size;
 public:
     PPMExporter(std::string outputfile);
     virtual ~PPMExporter();
     virtual void dumpImpl();
+
+    virtual TileRowWriter* getTileWriter() { return this; };
+
+    bool beginImage(int width, int height);
+    void writeRows(const char* rows, int count);
+    void endImage();
+};
+
+// YUV4MPEG2 stream of 4:2:0 frames, half the size of the equivalent PPM stream
+
+class Y4MExporter : public PPMExporter {
+protected:
+    unsigned char* yuv_pixels;
+    size_t yuv_size;
+
+    int chroma_width;
+    int chroma_height;
+
+    char y4mheader[1024];
+    bool header_written;
+
+    void convertFrame();
+public:
+    Y4MExporter(std::string outputfile, int framerate);
+    virtual ~Y4MExporter();
+    virtual void dumpImpl();
+
+    // continue an earlier stream, so the output can be appended to it
+    virtual void continueStream() { header_written = true; };
+
+    // the planes of a frame cannot be written a row at a time
+    virtual TileRowWriter* getTileWriter() { return 0; };
 };
 
 
@@ -27,6 +27,42 @@
 
 #include "regex.h"
 
+// maximum number of subject strings remembered by a RegexFilter
+#define REGEX_FILTER_CACHE_SIZE 100000
+
+// match data sized for the largest pattern seen, reused by each thread
+class RegexMatchData {
+    pcre2_match_data* match_data;
+    uint32_t pairs;
+public:
+    RegexMatchData() : match_data(0), pairs(0) {}
+
+    ~RegexMatchData() {
+        if(match_data != 0) pcre2_match_data_free(match_data);
+    }
+
+    pcre2_match_data* get(uint32_t required_pairs) {
+        if(match_data == 0 || required_pairs > pairs) {
+            if(match_data != 0) pcre2_match_data_free(match_data);
+
+            pairs      = required_pairs < 16 ? 16 : required_pairs;
+            match_data = pcre2_match_data_create(pairs, NULL);
+        }
+
+        return match_data;
+    }
+};
+
+pcre2_match_data* Regex::getMatchData(pcre2_code* re) {
+
+    static thread_local RegexMatchData thread_match_data;
+
+    uint32_t capture_count = 0;
+    pcre2_pattern_info(re, PCRE2_INFO_CAPTURECOUNT, &capture_count);
+
+    return thread_match_data.get(capture_count + 1);
+}
+
 Regex::Regex(std::string regex, bool test) {
 
     int errornumber;
@@ -50,6 +86,7 @@ Regex::Regex(std::string regex, bool test) {
 
     } else {
         valid = true;
+        jitCompile();
     }
 
 }
@@ -58,6 +95,7 @@ Regex::Regex(const Regex& regex) {
     if(regex.isValid()) {
         re = pcre2_code_copy(regex.re);
         valid = true;
+        jitCompile();
     } else {
         re = 0;
         valid = false;
@@ -72,6 +110,22 @@ bool Regex::isValid() const {
     return valid;
 }
 
+// JIT compile where supported. pcre2_match uses the JIT code automatically,
+// if it is unavailable (e.g. no JIT support for the platform) the pattern is
+// interpreted as before.
+void Regex::jitCompile() {
+    pcre2_jit_compile(re, PCRE2_JIT_COMPLETE);
+}
+
+int Regex::getBackReferenceMax() const {
+    if(!valid) return 0;
+
+    uint32_t backref_max = 0;
+    pcre2_pattern_info(re, PCRE2_INFO_BACKREFMAX, &backref_max);
+
+    return backref_max;
+}
+
 bool Regex::replace(std::string& str, const std::string& replacement_str) {
 
     int offset = replaceOffset(str, replacement_str, 0);
@@ -91,7 +145,7 @@ bool Regex::replaceAll(std::string& str, const std::string& replacement_str) {
 
 int Regex::replaceOffset(std::string& str, const std::string& replacement_str, int offset) {
     
-    pcre2_match_data* match_data = pcre2_match_data_create_from_pattern(re, NULL);
+    pcre2_match_data* match_data = getMatchData(re);
 
     int rc = pcre2_match(
         re,
@@ -105,7 +159,6 @@ int Regex::replaceOffset(std::string& str, const std::string& replacement_str, i
 
     //failed match
     if(rc<1) {
-        pcre2_match_data_free(match_data);
         return -1;
     }
 
@@ -141,7 +194,6 @@ int Regex::replaceOffset(std::string& str, const std::string& replacement_str, i
     }
 
     str = new_str;
-    pcre2_match_data_free(match_data);
 
     return end_offset;        
 }
@@ -173,7 +225,7 @@ int Regex::matchOffset(const std::string& str, std::vector<std::string>* results
     
     if(offset >= str.size()) return -1;
 
-    pcre2_match_data* match_data = pcre2_match_data_create_from_pattern(re, NULL);
+    pcre2_match_data* match_data = getMatchData(re);
 
     int rc = pcre2_match(
         re,
@@ -189,7 +241,6 @@ int Regex::matchOffset(const std::string& str, std::vector<std::string>* results
 
     //failed match
     if(rc < 1) {
-        pcre2_match_data_free(match_data);
         return -1;
     }
 
@@ -212,7 +263,197 @@ int Regex::matchOffset(const std::string& str, std::vector<std::string>* results
 
     int result_offset = ovector[1] + offset;
 
-    pcre2_match_data_free(match_data);
-
     return result_offset;
 }
+
+// RegexFilter
+
+RegexFilter::RegexFilter(bool match_all) : match_all(match_all) {
+    combined = 0;
+    compiled = false;
+}
+
+RegexFilter::RegexFilter(const RegexFilter& filter) {
+    combined  = 0;
+    compiled  = false;
+    match_all = filter.match_all;
+
+    for(const std::string& pattern : filter.patterns) {
+        add(pattern);
+    }
+}
+
+RegexFilter::~RegexFilter() {
+    clear();
+}
+
+RegexFilter& RegexFilter::operator=(const RegexFilter& filter) {
+    if(this == &filter) return *this;
+
+    clear();
+
+    match_all = filter.match_all;
+
+    for(const std::string& pattern : filter.patterns) {
+        add(pattern);
+    }
+
+    return *this;
+}
+
+// returns false if the expression is not valid, in which case it is not added
+bool RegexFilter::add(const std::string& regex) {
+    Regex* r = new Regex(regex, true);
+
+    if(!r->isValid()) {
+        delete r;
+        return false;
+    }
+
+    regexes.push_back(r);
+    patterns.push_back(regex);
+
+    reset();
+
+    return true;
+}
+
+void RegexFilter::clear() {
+    for(Regex* r : regexes) {
+        delete r;
+    }
+    regexes.clear();
+    patterns.clear();
+
+    reset();
+}
+
+void RegexFilter::reset() {
+    if(combined != 0) {
+        delete combined;
+        combined = 0;
+    }
+
+    compiled = false;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.clear();
+}
+
+bool RegexFilter::empty() const {
+    return patterns.empty();
+}
+
+size_t RegexFilter::size() const {
+    return patterns.size();
+}
+
+bool RegexFilter::isCombined() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    if(!compiled) compile();
+
+    return combined != 0;
+}
+
+// patterns which refer to groups by number can't be combined
+// as the group numbering would change
+static bool regexUsesGroupNumbers(const std::string& pattern) {
+
+    for(size_t i=0; i+2 < pattern.size(); i++) {
+        if(pattern[i] == '\\') {
+            // \g<n> and \g'n' subroutine calls
+            if(pattern[i+1] == 'g' && (pattern[i+2] == '<' || pattern[i+2] == '\'')) return true;
+            i++;
+            continue;
+        }
+
+        // (?R), (?n), (?+n), (?-n) and (?&name) recursion
+        if(pattern[i] == '(' && pattern[i+1] == '?') {
+            char c = pattern[i+2];
+            if(c == 'R' || c == '&' || (c >= '0' && c <= '9')) return true;
+
+            if((c == '+' || c == '-') && i+3 < pattern.size() && pattern[i+3] >= '0' && pattern[i+3] <= '9') return true;
+        }
+    }
+
+    return false;
+}
+
+void RegexFilter::compile() {
+    compiled = true;
+
+    if(patterns.size() < 2) return;
+
+    for(size_t i=0; i < patterns.size(); i++) {
+        if(regexes[i]->getBackReferenceMax() > 0 || regexUsesGroupNumbers(patterns[i])) return;
+    }
+
+    std::string combined_pattern;
+
+    if(match_all) {
+        // each expression must match somewhere in the string
+        combined_pattern = "\\A";
+
+        for(const std::string& pattern : patterns) {
+            combined_pattern += "(?=[\\s\\S]*?(?:" + pattern + "))";
+        }
+    } else {
+        for(const std::string& pattern : patterns) {
+            if(!combined_pattern.empty()) combined_pattern += "|";
+            combined_pattern += "(?:" + pattern + ")";
+        }
+    }
+
+    Regex* r = new Regex(combined_pattern, true);
+
+    if(!r->isValid()) {
+        delete r;
+        return;
+    }
+
+    combined = r;
+}
+
+bool RegexFilter::matchUncached(const std::string& str) {
+
+    if(combined != 0) return combined->match(str);
+
+    for(Regex* r : regexes) {
+        bool matched = r->match(str);
+
+        if(match_all) {
+            if(!matched) return false;
+        } else if(matched) {
+            return true;
+        }
+    }
+
+    return match_all;
+}
+
+bool RegexFilter::match(const std::string& str) {
+
+    if(patterns.empty()) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+
+        if(!compiled) compile();
+
+        std::unordered_map<std::string, bool>::iterator it = cache.find(str);
+
+        if(it != cache.end()) return it->second;
+    }
+
+    // matched outside the lock, each thread having its own match data
+    bool result = matchUncached(str);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    if(cache.size() >= REGEX_FILTER_CACHE_SIZE) cache.clear();
+
+    cache[str] = result;
+
+    return result;
+}
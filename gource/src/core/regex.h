@@ -33,7 +33,9 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <exception>
+#include <mutex>
 
 class RegexCompilationException : public std::exception {
 protected:
@@ -50,8 +52,12 @@ protected:
     pcre2_code *re;
     bool valid;
 
+    void jitCompile();
+
     int replaceOffset(std::string& str, const std::string& replacement_str, int offset=0);
     int matchOffset(const std::string& str, std::vector<std::string>* results = 0, int offset=0);
+
+    static pcre2_match_data* getMatchData(pcre2_code* re);
 public:
     Regex(std::string regex, bool test = false);
     Regex(const Regex& regex);
@@ -65,6 +71,43 @@ public:
 
     bool isValid() const;
 
+    int getBackReferenceMax() const;
+};
+
+// A list of regular expressions tested as a unit. Where possible the list is
+// compiled into a single pattern (an alternation, or a chain of lookaheads when
+// every expression must match) and results are cached per subject string.
+
+class RegexFilter {
+protected:
+    std::vector<std::string> patterns;
+    std::vector<Regex*> regexes;
+    Regex* combined;
+    bool match_all;
+    bool compiled;
+
+    std::unordered_map<std::string, bool> cache;
+    std::mutex cache_mutex;
+
+    void compile();
+    void reset();
+    bool matchUncached(const std::string& str);
+public:
+    RegexFilter(bool match_all = false);
+    RegexFilter(const RegexFilter& filter);
+    ~RegexFilter();
+
+    RegexFilter& operator=(const RegexFilter& filter);
+
+    bool add(const std::string& regex);
+    void clear();
+
+    bool empty() const;
+    size_t size() const;
+
+    bool isCombined();
+
+    bool match(const std::string& str);
 };
 
 #endif
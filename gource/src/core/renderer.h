@@ -42,7 +42,12 @@ public:
 
     const glm::mat4& getProjection() const { return projection_; }
     const glm::mat4& getModelView() const { return modelview_; }
-    glm::mat4 getMVP() const { return projection_ * modelview_; }
+    glm::mat4 getMVP() const { return tile_ * projection_ * modelview_; }
+
+    // Maps a region of the image onto the viewport when rendering in tiles.
+    // Applied after the projection so screen positions are unaffected.
+    void setTile(const glm::mat4& tile) { tile_ = tile; }
+    const glm::mat4& getTile() const { return tile_; }
 
     // 2D/3D mode helpers
     void mode2D(int width, int height);
@@ -102,6 +107,7 @@ private:
     // Matrix stacks
     glm::mat4 projection_{1.0f};
     glm::mat4 modelview_{1.0f};
+    glm::mat4 tile_{1.0f};
     std::stack<glm::mat4> mv_stack_;
     std::stack<glm::mat4> proj_stack_;
 
@@ -161,6 +161,8 @@ float SeekLog::getPercent() {
 void SeekLog::setPointer(std::streampos pointer) {
     stream->clear();
     stream->seekg(pointer);
+
+    current_percent = (float) pointer / file_size;
 }
 
 std::streampos SeekLog::getPointer() {
@@ -19,6 +19,7 @@
 #include "regex.h"
 #include "timezone.h"
 #include "logger.h"
+#include "png_writer.h"
 
 Regex SDLAppSettings_rect_regex("^([0-9.]+)x([0-9.]+)$");
 Regex SDLAppSettings_viewport_regex("^([0-9.]+)x([0-9.]+)(!)?$");
@@ -38,6 +39,12 @@ SDLAppSettings::SDLAppSettings() {
     conf_sections["multi-sampling"]     = "display";
     conf_sections["output-ppm-stream"]  = "display";
     conf_sections["output-framerate"]   = "display";
+    conf_sections["output-format"]      = "display";
+    conf_sections["output-threads"]     = "display";
+    conf_sections["output-scale"]       = "display";
+    conf_sections["output-supersample"] = "display";
+    conf_sections["output-png-compression"] = "display";
+    conf_sections["output-png-filter"]  = "display";
     conf_sections["transparent"]        = "display";
     conf_sections["no-vsync"]           = "display";
     conf_sections["high-dpi"]           = "display";
@@ -61,6 +68,12 @@ SDLAppSettings::SDLAppSettings() {
     arg_types["high-dpi"]          = "bool";
     arg_types["output-ppm-stream"] = "string";
     arg_types["output-framerate"]  = "int";
+    arg_types["output-format"]     = "string";
+    arg_types["output-threads"]    = "int";
+    arg_types["output-scale"]      = "int";
+    arg_types["output-supersample"] = "int";
+    arg_types["output-png-compression"] = "int";
+    arg_types["output-png-filter"] = "string";
 
 }
 
@@ -87,6 +100,13 @@ void SDLAppSettings::setDisplayDefaults() {
 
     output_ppm_filename = "";
     output_framerate    = 60;
+    output_format       = "";
+    output_threads      = 0;
+    output_scale        = 1;
+    output_supersample  = 1;
+
+    output_png_compression = PNG_WRITER_DEFAULT_COMPRESSION;
+    output_png_filters     = PNG_WRITER_DEFAULT_FILTERS;
 }
 
 void SDLAppSettings::exportDisplaySettings(ConfFile& conf) {
@@ -453,6 +473,82 @@ void SDLAppSettings::importDisplaySettings(ConfFile& conffile) {
 
     }
 
+    if((entry = display_settings->getEntry("output-format")) != 0) {
+
+        if(!entry->hasValue()) {
+            conffile.entryException(entry, "specify output format (ppm,y4m,png)");
+        }
+
+        output_format = entry->getString();
+
+        if(output_format != "ppm" && output_format != "y4m" && output_format != "png") {
+            conffile.entryException(entry, "supported output formats are ppm,y4m,png");
+        }
+    }
+
+    if((entry = display_settings->getEntry("output-threads")) != 0) {
+
+        if(!entry->hasValue()) {
+            conffile.entryException(entry, "specify number of output threads");
+        }
+
+        output_threads = entry->getInt();
+
+        if(output_threads < 0) {
+            conffile.invalidValueException(entry);
+        }
+    }
+
+    if((entry = display_settings->getEntry("output-scale")) != 0) {
+
+        if(!entry->hasValue()) {
+            conffile.entryException(entry, "specify output scale (1-16)");
+        }
+
+        output_scale = entry->getInt();
+
+        if(output_scale < 1 || output_scale > 16) {
+            conffile.entryException(entry, "output scale must be between 1 and 16");
+        }
+    }
+
+    if((entry = display_settings->getEntry("output-supersample")) != 0) {
+
+        if(!entry->hasValue()) {
+            conffile.entryException(entry, "specify output supersampling (1-4)");
+        }
+
+        output_supersample = entry->getInt();
+
+        if(output_supersample < 1 || output_supersample > 4) {
+            conffile.entryException(entry, "output supersampling must be between 1 and 4");
+        }
+    }
+
+    if((entry = display_settings->getEntry("output-png-compression")) != 0) {
+
+        if(!entry->hasValue()) {
+            conffile.entryException(entry, "specify png compression level (0-9)");
+        }
+
+        output_png_compression = entry->getInt();
+
+        if(output_png_compression < 0 || output_png_compression > 9) {
+            conffile.entryException(entry, "png compression level must be between 0 and 9");
+        }
+    }
+
+    if((entry = display_settings->getEntry("output-png-filter")) != 0) {
+
+        if(!entry->hasValue()) {
+            conffile.entryException(entry, "specify png filter (none,sub,up,avg,paeth,all)");
+        }
+
+        if(!PNGWriter::parseFilters(entry->getString(), output_png_filters)) {
+            conffile.entryException(entry, "supported png filters are none,sub,up,avg,paeth,all");
+        }
+    }
+
     if((entry = display_settings->getEntry("output-framerate")) != 0) {
 
         if(!entry->hasValue()) {
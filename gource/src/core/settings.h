@@ -52,7 +52,13 @@ public:
     bool high_dpi;
 
     std::string output_ppm_filename;
+    std::string output_format;
     int output_framerate;
+    int output_threads;
+    int output_scale;
+    int output_supersample;
+    int output_png_compression;
+    int output_png_filters;
 
     SDLAppSettings();
 
@@ -0,0 +1,14 @@
+// === File: src/core/stringtable.cpp ==========================================
+// AGENT: PURPOSE    — Interned copies of strings shared by many objects
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "stringtable.h"
+
+const std::string* StringTable::intern(const std::string& str) {
+    return &(*strings.insert(str).first);
+}
+
+void StringTable::clear() {
+    strings.clear();
+}
@@ -0,0 +1,28 @@
+// === File: src/core/stringtable.h ============================================
+// AGENT: PURPOSE    — Interned copies of strings shared by many objects
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef CORE_STRING_TABLE_H
+#define CORE_STRING_TABLE_H
+
+#include <string>
+#include <unordered_set>
+
+// holds a single copy of each string added. the pointers returned stay
+// valid until the table is cleared, so equal strings can be compared by
+// pointer and stored in the space of one.
+
+class StringTable {
+    std::unordered_set<std::string> strings;
+public:
+    StringTable() {};
+
+    const std::string* intern(const std::string& str);
+
+    size_t size() const { return strings.size(); };
+
+    void clear();
+};
+
+#endif
@@ -41,6 +41,34 @@ TextureResource* TextureManager::grabFile(const std::string& filename, bool mipm
     return grab(filename, mipmaps, wrap, true);
 }
 
+bool TextureManager::isLoaded(const std::string& filename) {
+    return resources.find(filename) != resources.end();
+}
+
+// create a texture for an external image file from its decoded surface
+
+TextureResource* TextureManager::grabSurface(const std::string& filename, SDL_Surface* surface, bool mipmaps, GLint wrap) {
+
+    TextureResource* r = 0;
+
+    if((r = (TextureResource*) resources[filename]) != 0) {
+        r->addref();
+        return r;
+    }
+
+    r = new TextureResource(filename, mipmaps, wrap, true);
+
+    if(!r->loadSurface(surface)) {
+        resources.erase(filename);
+        delete r;
+        return 0;
+    }
+
+    addResource(r);
+
+    return r;
+}
+
 TextureResource* TextureManager::grab(const std::string& filename, bool mipmaps, GLint wrap, bool external) {
 
     TextureResource* r = 0;
@@ -245,6 +273,30 @@ void TextureResource::reload() {
     load(true);
 }
 
+// upload part of the data this texture was created from
+
+void TextureResource::reloadRegion(int x, int y, int width, int height) {
+
+    if(textureid == 0 || data == 0) {
+        load(true);
+        return;
+    }
+
+    int bytes_per_pixel = format == GL_RED ? 1 : 4;
+
+    glBindTexture(target, textureid);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, w);
+
+    glTexSubImage2D(target, 0, x, y, width, height, format == GL_RED ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, data + (x + y * w) * bytes_per_pixel);
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if(mipmaps) glGenerateMipmap(target);
+}
+
 void TextureResource::load(bool reload) {
 
     if(textureid != 0) {
@@ -257,55 +309,82 @@ void TextureResource::load(bool reload) {
     if(!filename.empty()) {
         debugLog("creating texture from %s", filename.c_str());
 
-        surface = IMG_Load(filename.c_str());
+        surface = decodeImage(filename);
 
         if(surface==0) throw TextureException(filename);
 
-        // Convert indexed images to RGBA for OpenGL compatibility
-        if(surface->format->palette && surface->format->BytesPerPixel == 1 && surface->format->palette->ncolors <= 256) {
-            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
-            SDL_FreeSurface(surface);
-            surface = converted;
-            if(surface == 0) {
-                throw TextureException(filename);
-            }
-        }
+        setSurface(surface);
 
-        // Convert BGRA/BGR to RGBA/RGB for WebGL compatibility
-        // WebGL doesn't support GL_BGRA or GL_BGR
-        if(surface->format->BytesPerPixel == 4 && surface->format->Rmask != 0x000000ff) {
-            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+        if(format==0) {
             SDL_FreeSurface(surface);
-            surface = converted;
-            if(surface == 0) {
-                throw TextureException(filename);
-            }
-        } else if(surface->format->BytesPerPixel == 3 && surface->format->Rmask != 0x000000ff) {
-            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGB24, 0);
-            SDL_FreeSurface(surface);
-            surface = converted;
-            if(surface == 0) {
-                throw TextureException(filename);
-            }
+            throw TextureException(filename);
         }
+    }
 
-        w = surface->w;
-        h = surface->h;
+    createTexture();
 
-        //figure out image colour order
-        format = colourFormat(surface);
+    if(surface != 0) {
+        SDL_FreeSurface(surface);
+        data = 0;
+    }
+}
+
+// create the texture from an image already decoded by decodeImage()
+
+bool TextureResource::loadSurface(SDL_Surface* surface) {
 
-        data = (GLubyte*) surface->pixels;
+    setSurface(surface);
 
-        if(format==0) throw TextureException(filename);
+    if(format == 0) {
+        data = 0;
+        return false;
     }
 
     createTexture();
 
-    if(surface != 0) {
+    data = 0;
+
+    return true;
+}
+
+void TextureResource::setSurface(SDL_Surface* surface) {
+    w = surface->w;
+    h = surface->h;
+
+    //figure out image colour order
+    format = colourFormat(surface);
+
+    data = (GLubyte*) surface->pixels;
+}
+
+// load an image and convert it to a format WebGL accepts. makes no GL calls,
+// so can be used from another thread. returns 0 if the image can't be loaded.
+
+SDL_Surface* TextureResource::decodeImage(const std::string& filename) {
+
+    SDL_Surface* surface = IMG_Load(filename.c_str());
+
+    if(surface==0) return 0;
+
+    Uint32 pixel_format = 0;
+
+    // Convert indexed images to RGBA for OpenGL compatibility, and BGRA/BGR
+    // to RGBA/RGB for WebGL compatibility as it doesn't support GL_BGRA or GL_BGR
+    if(surface->format->palette && surface->format->BytesPerPixel == 1 && surface->format->palette->ncolors <= 256) {
+        pixel_format = SDL_PIXELFORMAT_RGBA32;
+    } else if(surface->format->BytesPerPixel == 4 && surface->format->Rmask != 0x000000ff) {
+        pixel_format = SDL_PIXELFORMAT_RGBA32;
+    } else if(surface->format->BytesPerPixel == 3 && surface->format->Rmask != 0x000000ff) {
+        pixel_format = SDL_PIXELFORMAT_RGB24;
+    }
+
+    if(pixel_format != 0) {
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, pixel_format, 0);
         SDL_FreeSurface(surface);
-        data = 0;
+        surface = converted;
     }
+
+    return surface;
 }
 
 GLenum TextureResource::colourFormat(SDL_Surface* surface) {
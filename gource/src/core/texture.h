@@ -48,6 +48,7 @@ class TextureResource : public Resource {
     std::string filename;
 
     GLenum colourFormat(SDL_Surface* surface);
+    void setSurface(SDL_Surface* surface);
 public:
     int w, h;
     GLenum target;
@@ -69,8 +70,12 @@ public:
     void createTexture();
 
     void reload();
+    void reloadRegion(int x, int y, int width, int height);
 
     void load(bool reload = false);
+    bool loadSurface(SDL_Surface* surface);
+
+    static SDL_Surface* decodeImage(const std::string& filename);
 
     void unload();
 
@@ -89,6 +94,9 @@ public:
     TextureResource* grabFile(const std::string& filename, bool mipmaps = true, GLint wrap = GL_CLAMP_TO_EDGE);
     TextureResource*     grab(const std::string& filename, bool mipmaps = true, GLint wrap = GL_CLAMP_TO_EDGE, bool external_file = false);
 
+    TextureResource* grabSurface(const std::string& filename, SDL_Surface* surface, bool mipmaps = true, GLint wrap = GL_CLAMP_TO_EDGE);
+    bool isLoaded(const std::string& filename);
+
     TextureResource* create(int width, int height, bool mipmaps, GLint wrap, GLenum format, GLubyte* data  = 0);
     TextureResource* create(GLenum target = GL_TEXTURE_2D);
 
@@ -0,0 +1,164 @@
+// === File: src/core/tiled_render.cpp =========================================
+// AGENT: PURPOSE    — Offscreen tiled rendering of images larger than the window
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "tiled_render.h"
+#include "renderer.h"
+#include "display.h"
+
+#include <cstdio>
+#include <cstring>
+
+TiledRender::TiledRender(int scale, int supersample)
+    : scale(scale), supersample(supersample) {
+
+    tiles = scale * supersample;
+
+    tile_width  = display.width;
+    tile_height = display.height;
+
+    output_width  = display.width  * scale;
+    output_height = display.height * scale;
+
+    writer       = 0;
+    components   = 3;
+    strip_stride = 0;
+    summed_rows  = 0;
+
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &colour_buffer);
+    glGenRenderbuffers(1, &depth_buffer);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, colour_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, tile_width, tile_height);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, tile_width, tile_height);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colour_buffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  GL_RENDERBUFFER, depth_buffer);
+
+    complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(!complete) {
+        fprintf(stderr, "tiled render framebuffer is incomplete\n");
+    }
+}
+
+TiledRender::~TiledRender() {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &colour_buffer);
+    glDeleteRenderbuffers(1, &depth_buffer);
+}
+
+bool TiledRender::begin(TileRowWriter& writer) {
+    if(!complete) return false;
+
+    if(!writer.beginImage(output_width, output_height)) return false;
+
+    this->writer = &writer;
+    components   = writer.getComponents();
+
+    strip_stride = (size_t) tiles * tile_width * components;
+    strip.resize(strip_stride * tile_height);
+
+    row_sums.assign(output_width * components, 0);
+    output_row.resize(output_width * components);
+    summed_rows = 0;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    return true;
+}
+
+void TiledRender::beginTile(int tile) {
+
+    int column = tile % tiles;
+    int row    = tile / tiles;
+
+    // scale the tile's part of clip space up to fill the viewport.
+    // rows are numbered from the top of the image.
+    glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(tiles - 1 - 2 * column, -(tiles - 1 - 2 * row), 0.0f))
+                     * glm::scale(glm::mat4(1.0f), glm::vec3(tiles, tiles, 1.0f));
+
+    renderer().setTile(matrix);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, tile_width, tile_height);
+}
+
+void TiledRender::endTile(int tile) {
+
+    int column = tile % tiles;
+
+    GLenum pixel_format = components == 4 ? GL_RGBA : GL_RGB;
+
+    // read the tile straight into its place in the strip
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, tiles * tile_width);
+
+    glReadPixels(0, 0, tile_width, tile_height, pixel_format, GL_UNSIGNED_BYTE, &(strip[column * tile_width * components]));
+
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+    if(column != tiles - 1) return;
+
+    // strip is complete, rows were read bottom up
+    for(int y = tile_height - 1; y >= 0; y--) {
+        addRow((const unsigned char*) &(strip[y * strip_stride]));
+    }
+}
+
+// sum supersample x supersample blocks and write each completed output row
+
+void TiledRender::addRow(const unsigned char* row) {
+
+    if(supersample == 1) {
+        writer->writeRows((const char*) row, 1);
+        return;
+    }
+
+    int block = supersample * components;
+
+    for(int x = 0; x < output_width; x++) {
+        const unsigned char* pixel = row + x * block;
+        unsigned int* sum = &(row_sums[x * components]);
+
+        for(int s = 0; s < block; s += components) {
+            for(int c = 0; c < components; c++) {
+                sum[c] += pixel[s + c];
+            }
+        }
+    }
+
+    if(++summed_rows < supersample) return;
+
+    unsigned int samples = supersample * supersample;
+
+    for(size_t i = 0; i < row_sums.size(); i++) {
+        output_row[i] = (char) ((row_sums[i] + samples / 2) / samples);
+        row_sums[i] = 0;
+    }
+
+    summed_rows = 0;
+
+    writer->writeRows(&(output_row[0]), 1);
+}
+
+void TiledRender::end() {
+    renderer().setTile(glm::mat4(1.0f));
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, display.width, display.height);
+
+    if(writer != 0) {
+        writer->endImage();
+        writer = 0;
+    }
+}
@@ -0,0 +1,69 @@
+// === File: src/core/tiled_render.h ===========================================
+// AGENT: PURPOSE    — Offscreen tiled rendering of images larger than the window
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef CORE_TILED_RENDER_H
+#define CORE_TILED_RENDER_H
+
+#include "gl.h"
+
+#include <vector>
+
+// receives an image a row at a time, top to bottom
+
+class TileRowWriter {
+public:
+    virtual ~TileRowWriter() {};
+
+    virtual int  getComponents() { return 3; };
+    virtual bool beginImage(int width, int height) = 0;
+    virtual void writeRows(const char* rows, int count) = 0;
+    virtual void endImage() = 0;
+};
+
+// renders an image of (scale x supersample) window sized tiles into an
+// offscreen framebuffer. a row of tiles is read back at a time, box filtered
+// down by the supersample factor and passed to the writer, so memory use
+// depends on the tile size and output width rather than the output size.
+
+class TiledRender {
+    int scale;
+    int supersample;
+    int tiles;
+
+    int tile_width, tile_height;
+    int output_width, output_height;
+
+    GLuint framebuffer;
+    GLuint colour_buffer;
+    GLuint depth_buffer;
+    bool complete;
+
+    TileRowWriter* writer;
+    int components;
+
+    std::vector<char> strip;
+    size_t strip_stride;
+
+    std::vector<unsigned int> row_sums;
+    std::vector<char> output_row;
+    int summed_rows;
+
+    void addRow(const unsigned char* row);
+public:
+    TiledRender(int scale, int supersample);
+    ~TiledRender();
+
+    int getTileCount() const { return tiles * tiles; };
+
+    int getOutputWidth() const  { return output_width; };
+    int getOutputHeight() const { return output_height; };
+
+    bool begin(TileRowWriter& writer);
+    void beginTile(int tile);
+    void endTile(int tile);
+    void end();
+};
+
+#endif
@@ -140,6 +140,29 @@ void quadbuf::add(GLuint textureid, const quadbuf_vertex& v1, const quadbuf_vert
     }
 }
 
+quadbuf_vertex* quadbuf::reserve(int quad_count) {
+
+    int required = vertex_count + quad_count * 4;
+
+    if(required > vertex_capacity) {
+        resize(required*2);
+    }
+
+    return data + vertex_count;
+}
+
+void quadbuf::commit(GLuint textureid, int quad_count) {
+    if(quad_count <= 0) return;
+
+    int i = vertex_count;
+
+    vertex_count += quad_count * 4;
+
+    if(textureid>0 && (textures.empty() || textures.back().textureid != textureid)) {
+        textures.push_back(quadbuf_tex(i, textureid));
+    }
+}
+
 void quadbuf::initVAO() {
     if(vao == 0) {
         glGenVertexArrays(1, &vao);
@@ -137,6 +137,11 @@ public:
     void add(GLuint textureid, const vec2& pos, const vec2& dims, const vec4& colour, const vec4& texcoord);
     void add(GLuint textureid, const quadbuf_vertex& v1, const quadbuf_vertex& v2, const quadbuf_vertex& v3, const quadbuf_vertex& v4);
 
+    // space for up to quad_count quads to be written directly, followed
+    // by commit() with the number of quads actually written
+    quadbuf_vertex* reserve(int quad_count);
+    void commit(GLuint textureid, int quad_count);
+
     void update();
     void draw(bool use_own_shader = true);  // if false, uses externally bound shader
 };
@@ -27,6 +27,17 @@ float gGourceMinDirSize   = 15.0;
 float gGourceForceGravity = 10.0;
 float gGourceDirPadding   = 1.5;
 
+//on screen file sizes (in pixels) at which the files of large
+//directories are collapsed to a single disc and expanded again
+float gGourceCollapsePixels = 1.0;
+float gGourceExpandPixels   = 1.5;
+
+//interval at which the files of collapsed directories are updated
+float gGourceCollapsedUpdateInterval = 0.5;
+
+//speed below which a directory is considered to be at rest
+float gGourceDirRestSpeed = 0.5;
+
 bool  gGourceNodeDebug    = false;
 bool  gGourceGravity      = true;
 
@@ -64,8 +75,18 @@ RDirNode::RDirNode(RDirNode* parent, const std::string & abspath) {
     visible_count = 0;
 
     visible = false;
+    in_frustum = false;
     position_initialized = false;
 
+    collapsed    = false;
+    collapsed_dt = 0.0;
+    files_radius = 0.0;
+    file_layout  = 0;
+
+    sleeping        = false;
+    sleep_dt        = 0.0;
+    since_last_move = 0.0;
+
     since_node_visible = 0.0;
     since_last_file_change = 0.0;
     since_last_node_change = 0.0;
@@ -110,6 +131,8 @@ void RDirNode::fileUpdated(bool userInitiated) {
 }
 
 void RDirNode::nodeUpdated(bool userInitiated) {
+    wake();
+
     if(userInitiated) since_last_node_change = 0.0;
 
     calcRadius();
@@ -118,27 +141,6 @@ void RDirNode::nodeUpdated(bool userInitiated) {
     if(parent !=0) parent->nodeUpdated(true);
 }
 
-void RDirNode::rotate(float s, float c) {
-    pos  = rotate_vec2(pos,  s, c);
-    spos = rotate_vec2(spos, s, c);
-
-    for(std::list<RDirNode*>::iterator it = children.begin(); it != children.end(); it++) {
-        RDirNode* child = (*it);
-        child->rotate(s, c);
-    }
-}
-
-void RDirNode::rotate(float s, float c, const vec2& centre) {
-
-    pos  = rotate_vec2(pos - centre,  s, c) + centre;
-    spos = rotate_vec2(spos - centre, s, c) + centre;
-
-    for(std::list<RDirNode*>::iterator it = children.begin(); it != children.end(); it++) {
-        RDirNode* child = (*it);
-        child->rotate(s, c, centre);
-    }
-}
-
 void RDirNode::setPos(const vec2 & pos) {
     this->pos = pos;
 }
@@ -191,7 +193,7 @@ void RDirNode::findDirs(const std::string& path, std::list<RDirNode*>& dirs) {
 void RDirNode::getFilesRecursive(std::list<RFile*>& files) const {
 
     //add this dirs files
-    files.insert(files.begin(), this->files.begin(), this->files.end());
+    files.insert(files.begin(), this->files.files.begin(), this->files.files.end());
 
     for(std::list<RDirNode*>::const_iterator it = children.begin(); it != children.end(); it++) {
         (*it)->getFilesRecursive(files);
@@ -279,25 +281,23 @@ RDirNode* RDirNode::getRoot() {
 // note - you still need to delete the file yourself
 bool RDirNode::removeFile(RFile* f) {
     //doesnt match this path at all
-    if(f->path.find(abspath) != 0) {
+    if(f->getPath().find(abspath) != 0) {
         return false;
     }
 
     //is this dir - add to this node
-    if(f->path.compare(abspath) == 0) {
+    if(f->getPath().compare(abspath) == 0) {
 
-        for(std::list<RFile*>::iterator it = files.begin(); it != files.end(); it++) {
-            if((*it)==f) {
-                files.erase(it);
-                if(!f->isHidden()) visible_count--;
+        if(f->getDir() != this) return false;
 
-                fileUpdated(false);
+        if(!f->isHidden()) visible_count--;
 
-                return true;
-            }
-        }
+        files.remove(f->getSlot());
+        f->setDir(0, -1);
 
-        return false;
+        fileUpdated(false);
+
+        return true;
     }
 
     //does this belong to one of the children ?
@@ -326,9 +326,9 @@ bool RDirNode::removeFile(RFile* f) {
 
 
 void RDirNode::printFiles() {
-    for(std::list<RFile*>::iterator it = files.begin(); it != files.end(); it++) {
+    for(std::vector<RFile*>::iterator it = files.files.begin(); it != files.files.end(); it++) {
         RFile* file = (*it);
-        fprintf(stderr, "%s: %s %s\n", getPath().c_str(), file->fullpath.c_str() , file->isHidden() ? "hidden " : "");
+        fprintf(stderr, "%s: %s %s\n", getPath().c_str(), file->getFullPath().c_str() , file->isHidden() ? "hidden " : "");
     }
 }
 
@@ -338,6 +338,62 @@ void RDirNode::addVisible() {
     visible = true;
 }
 
+bool RDirNode::isCollapsed() const{
+    return collapsed;
+}
+
+bool RDirNode::isSleeping() const{
+    return sleeping;
+}
+
+// resume updating a directory and its parents, catching up on the
+// time spent asleep. child directories remain asleep but are credited
+// with the time so they can catch up when they are woken.
+
+void RDirNode::wake() {
+    if(!sleeping) return;
+
+    if(parent != 0) parent->wake();
+
+    sleeping = false;
+
+    for(std::list<RDirNode*>::iterator it = children.begin(); it != children.end(); it++) {
+        RDirNode* node = (*it);
+
+        if(node->sleeping) node->sleep_dt += sleep_dt;
+    }
+
+    if(collapsed) {
+        collapsed_dt += sleep_dt;
+    } else {
+        updateFiles(sleep_dt);
+    }
+
+    updateTickers(sleep_dt);
+
+    sleep_dt = 0.0;
+}
+
+// a directory can sleep once it and its files have settled and all of
+// its children are asleep
+
+bool RDirNode::canSleep() const{
+
+    float settle_time = std::max(5.0f, gGourceSettings.filename_time) + 1.0f;
+
+    if(since_last_move < settle_time) return false;
+    if(since_last_file_change < settle_time || since_last_node_change < settle_time) return false;
+
+    // files need to be updated to expire
+    if(gGourceSettings.file_idle_time > 0.0 && visible_count > 0) return false;
+
+    for(std::list<RDirNode*>::const_iterator it = children.begin(); it != children.end(); it++) {
+        if(!(*it)->sleeping) return false;
+    }
+
+    return true;
+}
+
 bool RDirNode::isVisible() {
 
     if(visible) return true;
@@ -382,7 +438,7 @@ std::string RDirNode::commonPathPrefix(const std::string & str) const{
 bool RDirNode::addFile(RFile* f) {
 
     //doesnt match this path at all
-    if(f->path.find(abspath) != 0) {
+    if(f->getPath().find(abspath) != 0) {
 
         if(parent != 0) return false;
 
@@ -393,7 +449,7 @@ bool RDirNode::addFile(RFile* f) {
 
         RDirNode* newparent;
 
-        std::string common = commonPathPrefix(f->path);
+        std::string common = commonPathPrefix(f->getPath());
         if(common.size()==0) common = "/";
 
         newparent = new RDirNode(0, common);
@@ -403,18 +459,19 @@ bool RDirNode::addFile(RFile* f) {
 
     //simply change path of node and add this to it
     if(   parent==0 && abspath == "/"
-       && f->path.compare(abspath) != 0 && noFiles() && noDirs()) {
-        debugLog("modifying root path to %s", f->path.c_str());
-        changePath(f->path);
+       && f->getPath().compare(abspath) != 0 && noFiles() && noDirs()) {
+        debugLog("modifying root path to %s", f->getPath().c_str());
+        changePath(f->getPath());
     }
 
     //is this dir - add to this node
-    if(f->path.compare(abspath) == 0) {
-        //debugLog("addFile %s to %s\n", f->fullpath.c_str(), abspath.c_str());
+    if(f->getPath().compare(abspath) == 0) {
+        //debugLog("addFile %s to %s\n", f->getFullPath().c_str(), abspath.c_str());
+
+        wake();
 
-        files.push_back(f);
+        f->setDir(this, files.add(f));
         if(!f->isHidden()) visible_count++;
-        f->setDir(this);
 
         fileUpdated(false);
 
@@ -438,11 +495,11 @@ bool RDirNode::addFile(RFile* f) {
     //that file is actually a directory - the file should be removed, and a directory with that path added
     //if this is the root node we do this regardless of if the file was added to a child node
 
-    for(std::list<RFile*>::const_iterator it = files.begin(); it != files.end(); it++) {
+    for(std::vector<RFile*>::const_iterator it = files.files.begin(); it != files.files.end(); it++) {
         RFile* file = (*it);
 
-        if(f->path.find(file->fullpath) == 0) {
-            //fprintf(stderr, "removing %s as is actually the directory of %s\n", file->fullpath.c_str(), f->fullpath.c_str());
+        if(file->isPrefixOf(f->getPath())) {
+            //fprintf(stderr, "removing %s as is actually the directory of %s\n", file->getFullPath().c_str(), f->getFullPath().c_str());
             file->remove();
             break;
         }
@@ -452,7 +509,7 @@ bool RDirNode::addFile(RFile* f) {
 
     //add new child, add it to that
     //if commonpath is longer than abspath, add intermediate node, else just add at the files path
-    RDirNode* node = new RDirNode(this, f->path);
+    RDirNode* node = new RDirNode(this, f->getPath());
 
     node->addFile(f);
 
@@ -466,8 +523,8 @@ bool RDirNode::addFile(RFile* f) {
      for(std::list<RDirNode*>::iterator it = children.begin(); it != children.end(); it++) {
          RDirNode* child =  (*it);
 
-         std::string common = child->commonPathPrefix(f->path);
-         if(common.size() > abspath.size() && common != f->path) {
+         std::string common = child->commonPathPrefix(f->getPath());
+         if(common.size() > abspath.size() && common != f->getPath()) {
             commonpath = common;
             commonPos = child->getPos();
             break;
@@ -512,17 +569,20 @@ float RDirNode::getRadiusSqrt() const{
     return dir_radius_sqrt;
 }
 
+float RDirNode::getFilesExtent() const{
+    return files.extent;
+}
+
 vec3 RDirNode::averageFileColour() const{
 
     vec3 av;
     int count = 0;
 
-    for(std::list<RFile*>::const_iterator it = files.begin(); it != files.end(); it++) {
-        RFile* file = (*it);
+    for(size_t i = 0; i < files.size(); i++) {
 
-        if(file->isHidden()) continue;
+        if(files.isHidden(i)) continue;
 
-        av += file->getColour();
+        av += files.getColour(i);
 
         count++;
     }
@@ -554,15 +614,20 @@ void RDirNode::calcColour() {
 
     col = vec4(brightness, brightness, brightness, 1.0);
 
+    files_colour = vec3(0.0f);
+
     int fcount = 0;
 
-    for(std::list<RFile*>::iterator it = files.begin(); it != files.end(); it++) {
-        RFile* file = (*it);
+    for(size_t i = 0; i < files.size(); i++) {
+
+        if(files.isHidden(i)) continue;
+
+        vec3 filecol = files.getColour(i);
+        float a       = files.getAlpha(i);
 
-        if(file->isHidden()) continue;;
+        files_colour += filecol;
 
-        vec3 filecol = file->getColour() * brightness;
-        float a       = file->getAlpha();
+        filecol *= brightness;
 
         col += vec4(filecol.x, filecol.y, filecol.z, a);
 
@@ -570,6 +635,8 @@ void RDirNode::calcColour() {
     }
 
     this->col /= (float) fcount + 1.0;
+
+    if(fcount > 0) files_colour /= (float) fcount;
 }
 
 float RDirNode::getArea() const{
@@ -621,6 +688,9 @@ void RDirNode::applyForceDir(RDirNode* node) {
 
     if(distance2>0.0) return;
 
+    //wake up sleeping directories we are moving into
+    if(node->sleeping && since_last_move == 0.0) node->wake();
+
     float posd = sqrt(posd2);
 
     float distance = posd - myradius - your_radius;
@@ -651,6 +721,8 @@ bool RDirNode::empty() const{
 
 void RDirNode::applyForces(QuadTree & quadtree) {
 
+    if(sleeping) return;
+
     //child nodes
     for(std::list<RDirNode*>::iterator it = children.begin(); it != children.end(); it++) {
         RDirNode* node = (*it);
@@ -800,6 +872,7 @@ void RDirNode::move(float dt) {
 
     //the root node is the centre of the world
     if(parent == 0) {
+        since_last_move += dt;
         return;
     }
 
@@ -808,6 +881,8 @@ void RDirNode::move(float dt) {
         setInitialPosition();
     }
 
+    vec2 old_pos = pos;
+
     // Check for NaN/Inf accel and reset if found
     if (std::isnan(accel.x) || std::isnan(accel.y) ||
         std::isinf(accel.x) || std::isinf(accel.y)) {
@@ -836,6 +911,12 @@ void RDirNode::move(float dt) {
     }
 
     accel = vec2(0.0, 0.0);
+
+    if(glm::length2(pos - old_pos) > gGourceDirRestSpeed * gGourceDirRestSpeed * dt * dt) {
+        since_last_move = 0.0;
+    } else {
+        since_last_move += dt;
+    }
 }
 
 const vec2 & RDirNode::getNodeNormal() const{
@@ -862,19 +943,24 @@ void RDirNode::updateFilePositions() {
 
     int files_left = visible_count;
 
-    for(std::list<RFile*>::iterator it = files.begin(); it!=files.end(); it++) {
-        RFile* f = *it;
+    files_radius = 0.0;
+
+    bool layout_changed = false;
 
-        if(f->isHidden()) {
-            f->setDest(vec2(0.0,0.0));
-            f->setDistance(0.0f);
-            continue;
+    for(size_t i = 0; i < files.size(); i++) {
+
+        vec2 dest(0.0f, 0.0f);
+
+        if(!files.isHidden(i)) dest = calcFileDest(max_files, file_no) * d;
+
+        if(dest != files.dest[i]) {
+            files.dest[i] = dest;
+            layout_changed = true;
         }
 
-        vec2 dest = calcFileDest(max_files, file_no);
+        if(files.isHidden(i)) continue;
 
-        f->setDest(dest);
-        f->setDistance(d);
+        files_radius = d + gGourceFileDiameter * 0.5;
 
         files_left--;
         file_no++;
@@ -891,6 +977,8 @@ void RDirNode::updateFilePositions() {
             file_no=0;
         }
     }
+
+    if(layout_changed) file_layout++;
 }
 
 void RDirNode::calcEdges() {
@@ -908,6 +996,11 @@ void RDirNode::calcEdges() {
 
 void RDirNode::logic(float dt) {
 
+    if(sleeping) {
+        sleep_dt += dt;
+        return;
+    }
+
     //move
     move(dt);
     updateSplinePoint(dt);
@@ -917,36 +1010,80 @@ void RDirNode::logic(float dt) {
         node_normal = normalise(pos - parent->getPos());
     }
 
-    //update files
-     for(std::list<RFile*>::iterator it = files.begin(); it!=files.end(); it++) {
-         RFile* f = *it;
-
-         f->logic(dt);
-     }
+    //update files, deferring the updates of collapsed directories
+    if(!collapsed) {
+        updateFiles(dt);
+    } else if((collapsed_dt += dt) >= gGourceCollapsedUpdateInterval) {
+        updateFiles(collapsed_dt);
+        collapsed_dt = 0.0;
+    }
 
-    //update child nodes
+    //update child nodes, waking them if this node is moving
     for(std::list<RDirNode*>::iterator it = children.begin(); it != children.end(); it++) {
         RDirNode* node = (*it);
 
+        if(since_last_move == 0.0) node->wake();
+
         node->logic(dt);
     }
 
     //update colour
-    calcColour();
+    if(!collapsed || collapsed_dt == 0.0) calcColour();
 
-    //update tickers
+    updateTickers(dt);
+
+    if(canSleep()) {
+        sleeping = true;
+        sleep_dt = 0.0;
+    }
+}
+
+void RDirNode::updateTickers(float dt) {
     if(visible) since_node_visible += dt;
 
     since_last_file_change += dt;
     since_last_node_change += dt;
 }
 
-void RDirNode::drawDirName(FXFont& dirfont) const{
-    if(parent==0) return;
-    if(gGourceSettings.hide_dirnames) return;
-    if(gGourceSettings.dir_name_depth > 0 && gGourceSettings.dir_name_depth < (depth-1)) return;
+void RDirNode::updateFiles(float dt) {
+    files.logic(dt);
+}
 
-    if(!gGourceSettings.highlight_dirs && since_last_node_change > 5.0) return;
+// collapse the files of large directories into a single disc when they
+// are off screen or too small to be distinguished
+
+void RDirNode::updateDetail(float pixels_per_unit) {
+
+    bool collapsible = gGourceSettings.dir_lod_files > 0 && visible_count >= gGourceSettings.dir_lod_files;
+
+    float file_pixels = gGourceFileDiameter * pixels_per_unit;
+
+    if(collapsed) {
+        if(collapsible && (!in_frustum || file_pixels < gGourceExpandPixels)) return;
+
+        // catch up on updates deferred while collapsed
+        updateFiles(collapsed_dt);
+        collapsed_dt = 0.0;
+        collapsed = false;
+
+    } else if(collapsible && (!in_frustum || file_pixels < gGourceCollapsePixels)) {
+        collapsed_dt = 0.0;
+        collapsed = true;
+    }
+}
+
+bool RDirNode::dirNameVisible() const {
+    if(parent==0) return false;
+    if(gGourceSettings.hide_dirnames) return false;
+    if(gGourceSettings.dir_name_depth > 0 && gGourceSettings.dir_name_depth < (depth-1)) return false;
+
+    if(!gGourceSettings.highlight_dirs && since_last_node_change > 5.0) return false;
+
+    return true;
+}
+
+void RDirNode::drawDirName(FXFont& dirfont) const{
+    if(!dirNameVisible()) return;
 
     float alpha = gGourceSettings.highlight_dirs ? 1.0 : std::max(0.0f, 5.0f - since_last_node_change) / 5.0f;
 
@@ -978,10 +1115,10 @@ void RDirNode::calcScreenPos(GLint* viewport, GLdouble* modelview, GLdouble* pro
     static vec2 selected_offset(5.5f, -2.0f);
     static vec2 unselected_offset(5.5f, -1.0f);
 
-    if(!gGourceSettings.hide_filenames) {
+    if(!gGourceSettings.hide_filenames && !collapsed) {
 
         //first pass - calculate positions of names
-        for(std::list<RFile*>::const_iterator it = files.begin(); it!=files.end(); it++) {
+        for(std::vector<RFile*>::const_iterator it = files.files.begin(); it!=files.files.end(); it++) {
             RFile* f = *it;
             f->calcScreenPos(viewport, modelview, projection);
         }
@@ -1001,8 +1138,8 @@ void RDirNode::drawNames(FXFont& dirfont) {
 
     if(!gGourceSettings.hide_filenames) {
 
-        if(!(gGourceSettings.hide_filenames || gGourceSettings.hide_files) && in_frustum) {
-            for(std::list<RFile*>::const_iterator it = files.begin(); it!=files.end(); it++) {
+        if(!(gGourceSettings.hide_filenames || gGourceSettings.hide_files) && in_frustum && !collapsed) {
+            for(std::vector<RFile*>::const_iterator it = files.files.begin(); it!=files.files.end(); it++) {
                 RFile* f = *it;
                 if(!f->isSelected()) f->drawName();
             }
@@ -1016,25 +1153,84 @@ void RDirNode::drawNames(FXFont& dirfont) {
     }
 }
 
-void RDirNode::checkFrustum(const Frustum& frustum) {
+// queue the names drawNames would draw so overlapping labels can be culled
+
+void RDirNode::queueNames(RLabelGrid& grid, FXFont& dirfont) {
+
+    if(!gGourceSettings.hide_dirnames && isVisible() && dirNameVisible()) {
+        const vec2& label_pos = spline.getLabelPos();
+
+        vec2 dims(dirfont.getWidth(path_token), dirfont.getHeight());
+
+        grid.addDirName(this, vec2(label_pos.x, label_pos.y - dirfont.getAscender()), dims, since_last_node_change);
+    }
+
+    if(!(gGourceSettings.hide_filenames || gGourceSettings.hide_files) && in_frustum && !collapsed) {
+        for(std::vector<RFile*>::const_iterator it = files.files.begin(); it!=files.files.end(); it++) {
+            RFile* f = *it;
+            if(!f->isSelected()) f->queueName(grid);
+        }
+    }
+
+    for(std::list<RDirNode*>::const_iterator it = children.begin(); it != children.end(); it++) {
+        RDirNode* node = (*it);
+        node->queueNames(grid, dirfont);
+    }
+}
+
+void RDirNode::checkFrustum(const Frustum& frustum, float pixels_per_unit) {
 
     in_frustum = frustum.intersects(quadItemBounds);
 
+    updateDetail(pixels_per_unit);
+
     for(std::list<RDirNode*>::const_iterator it = children.begin(); it != children.end(); it++) {
         RDirNode* node = (*it);
-        node->checkFrustum(frustum);
+        node->checkFrustum(frustum, pixels_per_unit);
     }
 }
 
+void RDirNode::drawCollapsedFiles(const vec4& colour, const vec2& offset) const{
+
+    float radius = files_radius;
+
+    auto& r = renderer();
+    r.bindTexture(gGourceSettings.file_graphic->textureid);
+
+    r.pushModelView();
+    r.translateMV(pos.x + offset.x, pos.y + offset.y, 0.0f);
+
+    r.color(colour.x, colour.y, colour.z, colour.w);
+
+    r.begin(GL_QUADS);
+        r.texcoord(0.0f, 0.0f);
+        r.vertex(-radius, -radius);
+
+        r.texcoord(1.0f, 0.0f);
+        r.vertex(radius, -radius);
+
+        r.texcoord(1.0f, 1.0f);
+        r.vertex(radius, radius);
+
+        r.texcoord(0.0f, 1.0f);
+        r.vertex(-radius, radius);
+    r.end();
+
+    r.popModelView();
+}
+
 void RDirNode::drawShadows(float dt) const{
 
-    if(in_frustum) {
+    if(in_frustum && collapsed) {
+        drawCollapsedFiles(vec4(0.0f, 0.0f, 0.0f, gGourceShadowStrength), vec2(2.0f, 2.0f));
+
+    } else if(in_frustum) {
         auto& r = renderer();
         r.pushModelView();
         r.translateMV(pos.x, pos.y, 0.0f);
 
         //draw files
-        for(std::list<RFile*>::const_iterator it = files.begin(); it!=files.end(); it++) {
+        for(std::vector<RFile*>::const_iterator it = files.files.begin(); it!=files.files.end(); it++) {
             RFile* f = *it;
             if(f->isHidden()) continue;
 
@@ -1052,18 +1248,22 @@ void RDirNode::drawShadows(float dt) const{
 
 void RDirNode::updateFilesVBO(quadbuf& buffer, float dt) const{
 
-    if(in_frustum) {
+    if(in_frustum && collapsed) {
 
-        for(std::list<RFile*>::const_iterator it = files.begin(); it!=files.end(); it++) {
-            RFile* f = *it;
+        vec2 dims(files_radius * 2.0f, files_radius * 2.0f);
 
-            if(f->isHidden()) continue;
+        buffer.add(gGourceSettings.file_graphic->textureid, pos - dims*0.5f, dims, vec4(files_colour.x, files_colour.y, files_colour.z, 1.0f));
 
-            vec3 col   = f->getColour();
-            float alpha = f->getAlpha();
+    } else if(in_frustum) {
 
-            buffer.add(f->graphic->textureid, f->getAbsolutePos() - f->dims*0.5f, f->dims, vec4(col.x, col.y, col.z, alpha));
-        }
+        GLuint textureid = gGourceSettings.file_graphic->textureid;
+
+        vec2 dims   = RFile::getDims();
+        vec2 offset = pos - dims*0.5f;
+
+        quadbuf_vertex* vertices = buffer.reserve(files.size());
+
+        buffer.commit(textureid, files.fillQuads(vertices, offset, dims));
     }
 
     for(std::list<RDirNode*>::const_iterator it = children.begin(); it != children.end(); it++) {
@@ -1095,13 +1295,16 @@ void RDirNode::updateBloomVBO(bloombuf& buffer, float dt) {
 
 void RDirNode::drawFiles(float dt) const{
 
-    if(in_frustum) {
+    if(in_frustum && collapsed) {
+        drawCollapsedFiles(vec4(files_colour.x, files_colour.y, files_colour.z, 1.0f), vec2(0.0f, 0.0f));
+
+    } else if(in_frustum) {
         auto& r = renderer();
         r.pushModelView();
         r.translateMV(pos.x, pos.y, 0.0f);
 
         //draw files
-        for(std::list<RFile*>::const_iterator it = files.begin(); it!=files.end(); it++) {
+        for(std::vector<RFile*>::const_iterator it = files.files.begin(); it!=files.files.end(); it++) {
             RFile* f = *it;
             if(f->isHidden()) continue;
 
@@ -27,8 +27,10 @@
 #include "gource_settings.h"
 
 #include "spline.h"
+#include "filestore.h"
 #include "file.h"
 #include "bloom.h"
+#include "labelgrid.h"
 
 #include <list>
 #include <set>
@@ -43,7 +45,7 @@ class RDirNode : public QuadItem {
 
     RDirNode* parent;
     std::list<RDirNode*> children;
-    std::list<RFile*> files;
+    RFileStore files;
 
     SplineEdge spline;
 
@@ -64,6 +66,16 @@ class RDirNode : public QuadItem {
     bool in_frustum;
     bool position_initialized;
 
+    bool collapsed;
+    float collapsed_dt;
+
+    bool sleeping;
+    float sleep_dt;
+    float since_last_move;
+    vec3 files_colour;
+    float files_radius;
+    int file_layout;
+
     float since_node_visible;
     float since_last_file_change;
     float since_last_node_change;
@@ -96,9 +108,15 @@ class RDirNode : public QuadItem {
     vec2 calcFileDest(int layer_no, int file_no);
     void updateFilePositions();
 
+    void updateFiles(float dt);
+    void updateTickers(float dt);
+    bool canSleep() const;
+    void updateDetail(float pixels_per_unit);
+    void drawCollapsedFiles(const vec4& colour, const vec2& offset) const;
+
     void adjustDepth();
     void adjustPath();
-    void drawDirName(FXFont& dirfont) const;
+    bool dirNameVisible() const;
 public:
     RDirNode(RDirNode* parent, const std::string & abspath);
     ~RDirNode();
@@ -117,6 +135,11 @@ public:
     void addVisible();
     bool isVisible();
 
+    bool isCollapsed() const;
+
+    void wake();
+    bool isSleeping() const;
+
     float getArea() const;
 
     int totalDirCount() const;
@@ -150,8 +173,13 @@ public:
     float getParentRadius() const;
     float getRadius() const;
     float getRadiusSqrt() const;
+    float getFilesExtent() const;
+
+    // changes whenever the destination of a file changes
+    int getFileLayout() const { return file_layout; };
 
-    const std::list<RFile*>* getFiles() const { return &files; };
+    const std::vector<RFile*>* getFiles() const { return &files.files; };
+    RFileStore& getFileStore() { return files; };
     void getFilesRecursive(std::list<RFile*>& files) const;
 
     vec3 averageFileColour() const;
@@ -172,9 +200,6 @@ public:
 
     void setPos(const vec2 & pos);
 
-    void rotate(float s, float c);
-    void rotate(float s, float c, const vec2& centre);
-
     void setParent(RDirNode* parent);
 
     float distanceToParent() const;
@@ -193,7 +218,7 @@ public:
     void drawEdges() const;
     void drawEdgeShadows() const;
 
-    void checkFrustum(const Frustum & frustum);
+    void checkFrustum(const Frustum & frustum, float pixels_per_unit);
 
     void updateFilesVBO(quadbuf& buffer, float dt) const;
     void updateBloomVBO(bloombuf& buffer, float dt);
@@ -202,7 +227,9 @@ public:
     void drawFiles(float dt) const;
     void drawBloom(float dt);
 
+    void drawDirName(FXFont& dirfont) const;
     void drawNames(FXFont& dirfont);
+    void queueNames(RLabelGrid& grid, FXFont& dirfont);
 
     void calcScreenPos(GLint* viewport, GLdouble* modelview, GLdouble* projection);
 
@@ -248,6 +275,8 @@ extern int gGourceDirNodeInnerLoops;
 extern int gGourceFileInnerLoops;
 
 extern float gGourcePointSize;
+extern float gGourceCollapsePixels;
+extern float gGourceExpandPixels;
 extern bool  gGourceNodeDebug;
 extern bool  gGourceGravity;
 extern float gGourceForceGravity;
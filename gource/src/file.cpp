@@ -20,41 +20,23 @@
 */
 
 #include "file.h"
+#include "pawn.h"
 #include "core/renderer.h"
 
 float gGourceFileDiameter  = 8.0;
 
 std::vector<RFile*> gGourceRemovedFiles;
 
+// paths and extensions are shared by many files
+StringTable gGourceFileStrings;
+
 FXFont file_selected_font;
 FXFont file_font;
 
-RFile::RFile(const std::string & name, const vec3 & colour, const vec2 & pos, int tagid) : Pawn(name,pos,tagid) {
-    hidden = true;
-    size = gGourceFileDiameter * 1.05;
-    radius = size * 0.5;
-
-    setGraphic(gGourceSettings.file_graphic);
-
-    speed = 5.0;
-    nametime = gGourceSettings.filename_time;
-    name_interval = nametime;
-
-    namecol     = vec3(1.0, 1.0, 1.0);
-    file_colour = colour;
-
-    last_action    = 0.0f;
-    fade_start     = -1.0f;
-    removed_timestamp = 0;
-    expired        = false;
-    forced_removal = false;
-    removing       = false;
-
-    shadow = true;
+// the fonts are loaded when a name is first shown, so files can be
+// created without a display
 
-    distance = 0;
-
-    setFilename(name);
+static void load_file_fonts() {
 
     if(!file_selected_font.initialized()) {
         file_selected_font = fontmanager.grab(gGourceSettings.font_file, 18);
@@ -69,29 +51,64 @@ RFile::RFile(const std::string & name, const vec3 & colour, const vec2 & pos, in
         file_font.roundCoordinates(false);
         file_font.setColour(vec4(gGourceSettings.filename_colour, 1.0f));
     }
+}
+
+RFile::RFile(const std::string & name, int tagid) {
+    this->tagid = tagid;
 
-    setSelected(false);
+    dir  = 0;
+    slot = -1;
 
-    dir = 0;
+    removed_timestamp = 0;
+    mouseover = false;
+
+    setFilename(name);
 }
 
 RFile::~RFile() {
 }
 
+RFileStore& RFile::store() const {
+    return dir->getFileStore();
+}
+
+unsigned char& RFile::flags() const {
+    return store().flags[slot];
+}
+
+float RFile::getSize() {
+    return gGourceFileDiameter * 1.05;
+}
+
+vec2 RFile::getDims() {
+    TextureResource* graphic = gGourceSettings.file_graphic;
+
+    float graphic_ratio = graphic ? graphic->h / (float) graphic->w : 1.0f;
+
+    return vec2(getSize(), getSize() * graphic_ratio);
+}
+
 void RFile::remove(time_t removed_timestamp) {
-    last_action = elapsed;
-    fade_start  = elapsed;
-    removing = true;
+    //bring the file up to date before it starts fading
+    dir->wake();
+
+    RFileStore& files = store();
+
+    files.last_action[slot] = files.elapsed[slot];
+    files.fade_start[slot]  = files.elapsed[slot];
+    files.flags[slot] |= RFILE_REMOVING;
+
     this->removed_timestamp = removed_timestamp;
 }
 
 void RFile::remove() {
-    forced_removal = true;
+    flags() |= RFILE_FORCED_REMOVAL;
     remove(0);
 }
 
-void RFile::setDir(RDirNode* dir) {
-    this->dir = dir;
+void RFile::setDir(RDirNode* dir, int slot) {
+    this->dir  = dir;
+    this->slot = slot;
 }
 
 RDirNode* RFile::getDir() const{
@@ -99,32 +116,37 @@ RDirNode* RFile::getDir() const{
 }
 
 vec2 RFile::getAbsolutePos() const{
-    return pos + dir->getPos();
+    return store().pos[slot] + dir->getPos();
 }
 
 bool RFile::overlaps(const vec2& pos) const {
 
     vec2 abs_pos = getAbsolutePos();
 
-    float halfsize_x = size * 0.5f;
-    vec2 halfsize ( halfsize_x, halfsize_x * graphic_ratio );
+    vec2 halfsize = getDims() * 0.5f;
 
     Bounds2D file_bounds(abs_pos - halfsize, abs_pos + halfsize);
 
     return file_bounds.contains(pos);
 }
 
-void RFile::setFilename(const std::string& abs_file_path) {
+// is the full path of this file the start of str
+bool RFile::isPrefixOf(const std::string& str) const {
+    if(str.size() < path->size() + name.size()) return false;
+
+    return str.compare(0, path->size(), *path) == 0
+        && str.compare(path->size(), name.size(), name) == 0;
+}
 
-    fullpath = abs_file_path;
+void RFile::setFilename(const std::string& abs_file_path) {
 
-    size_t pos = fullpath.rfind('/');
+    size_t pos = abs_file_path.rfind('/');
 
     if(pos != std::string::npos) {
-        path = name.substr(0,pos+1);
-        name = name.substr(pos+1, std::string::npos);
+        path = gGourceFileStrings.intern(abs_file_path.substr(0,pos+1));
+        name = abs_file_path.substr(pos+1, std::string::npos);
     } else {
-        path = std::string("");
+        path = gGourceFileStrings.intern("");
         name = abs_file_path;
     }
 
@@ -132,123 +154,101 @@ void RFile::setFilename(const std::string& abs_file_path) {
     size_t dotsep = name.rfind(".");
 
     if(dotsep != std::string::npos && dotsep != name.size()-1) {
-        ext = name.substr(dotsep+1);
+        ext = gGourceFileStrings.intern(name.substr(dotsep+1));
     } else if(gGourceSettings.file_extension_fallback) {
-        ext = name;
+        ext = gGourceFileStrings.intern(name);
+    } else {
+        ext = gGourceFileStrings.intern("");
     }
 }
 
 void RFile::colourize() {
-    file_colour = ext.size() ? colourHash(ext) : vec3(1.0f, 1.0f, 1.0f);
-}
-
-const vec3& RFile::getNameColour() const{
-    return selected ? gGourceSettings.selection_colour : namecol;
+    setFileColour(ext->size() ? colourHash(*ext) : vec3(1.0f, 1.0f, 1.0f));
 }
 
 void RFile::setFileColour(const vec3 & colour) {
-    file_colour = colour;
+    store().file_colour[slot] = colour;
 }
 
 const vec3 & RFile::getFileColour() const{
-    return file_colour;
+    return store().file_colour[slot];
 }
 
 vec3 RFile::getColour() const{
-    if(selected) return vec3(1.0f);
-
-    float lc = elapsed - last_action;
-
-    if(lc<1.0f) {
-        return touch_colour * (1.0f-lc) + file_colour * lc;
-    }
-
-    return file_colour;
+    return store().getColour(slot);
 }
 
 float RFile::getAlpha() const{
-    float alpha = Pawn::getAlpha();
+    return store().getAlpha(slot);
+}
 
-    //user fades out if not doing anything
-    if(fade_start > 0.0f) {
-        alpha = 1.0 - glm::clamp(elapsed - fade_start, 0.0f, 1.0f);
-    }
+void RFile::setDest(const vec2 & dest) {
+    store().dest[slot] = dest;
+}
 
-    return alpha;
+vec2 RFile::getDest() const{
+    return store().dest[slot];
 }
 
-void RFile::logic(float dt) {
-    Pawn::logic(dt);
+bool RFile::isHidden() const {
+    return store().isHidden(slot);
+}
 
-    vec2 dest_pos = dest;
-/*
-    if(dir->getParent() != 0 && dir->noDirs()) {
-        vec2 dirnorm = dir->getNodeNormal();
-        dest_pos = dirnorm + dest;
-    }*/
+void RFile::setHidden(bool hidden) {
+    unsigned char& file_flags = flags();
 
-    dest_pos = dest_pos * distance;
+    if(!hidden && (file_flags & RFILE_HIDDEN)) {
+        dir->addVisible();
+    }
 
-    accel = dest_pos - pos;
+    if(hidden) file_flags |= RFILE_HIDDEN;
+    else       file_flags &= ~RFILE_HIDDEN;
+}
 
-    // apply accel
-    vec2 accel2 = accel * speed * dt;
+void RFile::setSelected(bool selected) {
+    unsigned char& file_flags = flags();
 
-    if(glm::length2(accel2) > glm::length2(accel)) {
-        accel2 = accel;
-    }
+    if(selected) file_flags |= RFILE_SELECTED;
+    else         file_flags &= ~RFILE_SELECTED;
+}
 
-    pos += accel2;
+bool RFile::isSelected() const {
+    return (flags() & RFILE_SELECTED) != 0;
+}
 
-    //files have no momentum
-    accel = vec2(0.0f, 0.0f);
+void RFile::showName() {
+    float& name_interval = store().name_interval[slot];
 
-    if(fade_start < 0.0f && gGourceSettings.file_idle_time > 0.0f && (elapsed - last_action) > gGourceSettings.file_idle_time) {
-        fade_start = elapsed;
-    }
-    
-    // has completely faded out
-    if(fade_start > 0.0f && !expired && (elapsed - fade_start) >= 1.0) {
+    if(name_interval <= 0.0) name_interval = gGourceSettings.filename_time;
+}
 
-        expired = true;
+void RFile::touch(time_t touched_timestamp, const vec3 & colour) {
+    RFileStore& files = store();
 
-        bool found = false;
-        for(std::vector<RFile*>::iterator it = gGourceRemovedFiles.begin(); it != gGourceRemovedFiles.end(); it++) {
-            if((*it) == this) {
-                found = true;
-                break;
-            }
-        }
+    unsigned char& file_flags = files.flags[slot];
 
-        if(!found) {
-            gGourceRemovedFiles.push_back(this);
-            //fprintf(stderr, "expiring %s\n", fullpath.c_str());
-        }
-    }
+    if((file_flags & RFILE_FORCED_REMOVAL) || ((file_flags & RFILE_REMOVING) && touched_timestamp < removed_timestamp)) return;
 
-    if(isHidden() && !forced_removal) elapsed = 0.0;
-}
+    dir->wake();
 
-void RFile::touch(time_t touched_timestamp, const vec3 & colour) {
-    if(forced_removal || (removing && touched_timestamp < removed_timestamp)) return;
+    //fprintf(stderr, "touch %s\n", getFullPath().c_str());
 
-    //fprintf(stderr, "touch %s\n", fullpath.c_str());
+    files.fade_start[slot]   = -1.0f;
+    files.last_action[slot]  = files.elapsed[slot];
+    files.touch_colour[slot] = colour;
 
-    fade_start = -1.0f;
-    removing = false;
+    file_flags &= ~RFILE_REMOVING;
     removed_timestamp = 0;
-    last_action = elapsed;
-    touch_colour = colour;
 
     //un expire file if touched after being removed
-    if(expired) {
+    if(file_flags & RFILE_EXPIRED) {
         for(std::vector<RFile*>::iterator it = gGourceRemovedFiles.begin(); it != gGourceRemovedFiles.end(); it++) {
             if((*it) == this) {
                 gGourceRemovedFiles.erase(it);
                 break;
             }
         }
-        expired=false;
+        file_flags &= ~RFILE_EXPIRED;
     }
 
     showName();
@@ -256,14 +256,6 @@ void RFile::touch(time_t touched_timestamp, const vec3 & colour) {
     dir->fileUpdated(true);
 }
 
-void RFile::setHidden(bool hidden) {
-    if(this->hidden==true && hidden==false && dir !=0) {
-        dir->addVisible();
-    }
-
-    Pawn::setHidden(hidden);
-}
-
 void RFile::calcScreenPos(GLint* viewport, GLdouble* modelview, GLdouble* projection) {
     // Convert GLdouble arrays to glm matrices
     glm::mat4 mv, proj;
@@ -276,7 +268,7 @@ void RFile::calcScreenPos(GLint* viewport, GLdouble* modelview, GLdouble* projec
     vec2 text_pos = getAbsolutePos();
     text_pos.x += 5.5f;
 
-    if(selected)
+    if(isSelected())
         text_pos.y -= 2.0f;
     else
         text_pos.y -= 1.0f;
@@ -286,20 +278,120 @@ void RFile::calcScreenPos(GLint* viewport, GLdouble* modelview, GLdouble* projec
     screenpos.y = (float)viewport[3] - screen.y;
 }
 
+bool RFile::nameVisible() const {
+    unsigned char file_flags = flags();
+
+    if(file_flags & RFILE_HIDDEN) return false;
+
+    return (file_flags & RFILE_SELECTED) || store().name_interval[slot] >= 0.0;
+}
+
+void RFile::queueName(RLabelGrid& grid) {
+    if(!nameVisible()) return;
+
+    load_file_fonts();
+
+    const std::string& label = gGourceSettings.file_extensions ? *ext : name;
+
+    vec2 label_pos(screenpos.x, screenpos.y - file_font.getAscender());
+    vec2 dims(file_font.getWidth(label), file_font.getHeight());
+
+    grid.addFileName(this, label_pos, dims, gGourceSettings.filename_time - store().name_interval[slot]);
+}
+
+void RFile::drawName() {
+    if(!nameVisible()) return;
+
+    float nametime = gGourceSettings.filename_time;
+    float done     = nametime - store().name_interval[slot];
+
+    if(done < 1.0) {
+        drawNameText(done);
+    } else if(done > 1.0 && done < nametime - 1.0) {
+        drawNameText(1.0);
+    } else {
+        drawNameText((nametime - done));
+    }
+}
+
 void RFile::drawNameText(float alpha) {
+    bool selected = isSelected();
+
     if(!selected && alpha <= 0.01) return;
 
     float name_alpha = selected ? 1.0 : alpha;
 
+    load_file_fonts();
+
     if(selected) {
         file_selected_font.draw(screenpos.x, screenpos.y, name);
     } else {
         file_font.setAlpha(name_alpha);
-        file_font.draw(screenpos.x, screenpos.y, gGourceSettings.file_extensions ? ext : name);
+        file_font.draw(screenpos.x, screenpos.y, gGourceSettings.file_extensions ? *ext : name);
     }
 }
 
+// immediate mode drawing, relative to the directory
+
+void RFile::drawShadow(float dt) {
+    if(isHidden()) return;
+
+    vec2 dims = getDims();
+    vec2 offsetpos = store().pos[slot] - dims * 0.5f + vec2(2.0f, 2.0f);
+
+    auto& r = renderer();
+    r.bindTexture(gGourceSettings.file_graphic->textureid);
+    r.color(0.0f, 0.0f, 0.0f, getAlpha() * gGourceShadowStrength);
+
+    r.pushModelView();
+    r.translateMV(offsetpos.x, offsetpos.y, 0.0f);
+
+    r.begin(GL_QUADS);
+        r.texcoord(0.0f, 0.0f);
+        r.vertex(0.0f, 0.0f);
+
+        r.texcoord(1.0f, 0.0f);
+        r.vertex(dims.x, 0.0f);
+
+        r.texcoord(1.0f, 1.0f);
+        r.vertex(dims.x, dims.y);
+
+        r.texcoord(0.0f, 1.0f);
+        r.vertex(0.0f, dims.y);
+    r.end();
+
+    r.popModelView();
+}
+
 void RFile::draw(float dt) {
-    Pawn::draw(dt);
-    // glLoadName not supported in WebGL (selection handled differently)
+    if(isHidden()) return;
+
+    vec2 dims = getDims();
+    vec2 offsetpos = store().pos[slot] - dims * 0.5f;
+
+    vec3 col = getColour();
+
+    auto& r = renderer();
+    r.bindTexture(gGourceSettings.file_graphic->textureid);
+
+    r.pushModelView();
+    r.translateMV(offsetpos.x, offsetpos.y, 0.0f);
+
+    r.color(col.x, col.y, col.z, getAlpha());
+
+    r.begin(GL_QUADS);
+        r.texcoord(0.0f, 0.0f);
+        r.vertex(0.0f, 0.0f);
+
+        r.texcoord(1.0f, 0.0f);
+        r.vertex(dims.x, 0.0f);
+
+        r.texcoord(1.0f, 1.0f);
+        r.vertex(dims.x, dims.y);
+
+        r.texcoord(0.0f, 1.0f);
+        r.vertex(0.0f, dims.y);
+    r.end();
+
+    r.popModelView();
 }
@@ -18,48 +18,56 @@
 #ifndef RFILE_H
 #define RFILE_H
 
-#include "pawn.h"
 #include "dirnode.h"
+#include "filestore.h"
 #include "core/stringhash.h"
+#include "core/stringtable.h"
 
 class RDirNode;
+class RLabelGrid;
 
-class RFile : public Pawn {
-    vec3 file_colour;
-    vec3 touch_colour;
+// a file is a handle to a slot in the RFileStore of its directory,
+// where its position, colour and timers are kept
 
+class RFile {
     RDirNode* dir;
+    int slot;
 
-    time_t removed_timestamp;
-    bool forced_removal;
-    bool expired;
-    bool removing;
-
-    float fade_start;
-    
-    float last_action;
+    std::string name;
+    const std::string* path;
+    const std::string* ext;
 
-    float radius;
+    int tagid;
 
-    vec2 dest;
-    float distance;
+    time_t removed_timestamp;
 
-   // FXLabel* label;
+    bool mouseover;
 
-    //GLuint namelist;
+    RFileStore& store() const;
+    unsigned char& flags() const;
 
     void setFilename(const std::string& abs_file_path);
 
-    const vec3& getNameColour() const;
+    bool nameVisible() const;
     void drawNameText(float alpha);
 public:
-    std::string path;
-    std::string fullpath;
-    std::string ext;
+    vec3 screenpos;
 
-    RFile(const std::string & name, const vec3 & colour, const vec2 & pos, int tagid);
+    RFile(const std::string & name, int tagid);
     ~RFile();
 
+    const std::string& getName() const { return name; }
+    const std::string& getPath() const { return *path; }
+    const std::string& getExt() const  { return *ext; }
+
+    std::string getFullPath() const { return *path + name; }
+    bool isPrefixOf(const std::string& str) const;
+
+    int getTagID() const { return tagid; }
+
+    static float getSize();
+    static vec2  getDims();
+
     bool overlaps(const vec2& pos) const;
 
     void setFileColour(const vec3 & colour);
@@ -72,14 +80,24 @@ public:
     void touch(time_t touch_timestamp, const vec3& colour);
 
     void setHidden(bool hidden);
+    bool isHidden() const;
+
+    void setSelected(bool selected);
+    bool isSelected() const;
+
+    void setMouseOver(bool over) { mouseover = over; }
+
+    void showName();
 
-    void setDest(const vec2 & dest){ this->dest = dest; }
-    void setDistance(float distance){ this->distance = distance; }
+    void setDest(const vec2 & dest);
+    vec2 getDest() const;
 
     void calcScreenPos(GLint* viewport, GLdouble* modelview, GLdouble* projection);
+    void queueName(RLabelGrid& grid);
 
-    void logic(float dt);
     void draw(float dt);
+    void drawShadow(float dt);
+    void drawName();
 
     void remove(time_t removed_timestamp);
     void remove();
@@ -87,7 +105,9 @@ public:
     vec2 getAbsolutePos() const;
 
     RDirNode* getDir() const;
-    void setDir(RDirNode* dir);
+    void setDir(RDirNode* dir, int slot);
+    void setSlot(int slot) { this->slot = slot; }
+    int getSlot() const { return slot; }
 };
 
 extern float gGourceFileDiameter;
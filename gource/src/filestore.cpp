@@ -0,0 +1,166 @@
+// === File: src/filestore.cpp =================================================
+// AGENT: PURPOSE    — Packed animation state of the files of a directory
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "filestore.h"
+#include "file.h"
+
+// files have no momentum and move this fraction of the way to
+// their destination per second
+#define RFILE_SPEED 5.0f
+
+vec3 RFileStore::getColour(int slot) const {
+    if(flags[slot] & RFILE_SELECTED) return vec3(1.0f);
+
+    float lc = elapsed[slot] - last_action[slot];
+
+    if(lc<1.0f) {
+        return touch_colour[slot] * (1.0f-lc) + file_colour[slot] * lc;
+    }
+
+    return file_colour[slot];
+}
+
+float RFileStore::getAlpha(int slot) const {
+
+    //file fades out if not doing anything
+    if(fade_start[slot] > 0.0f) {
+        return 1.0f - glm::clamp(elapsed[slot] - fade_start[slot], 0.0f, 1.0f);
+    }
+
+    return std::min(elapsed[slot], 1.0f);
+}
+
+int RFileStore::add(RFile* file) {
+
+    files.push_back(file);
+
+    pos.push_back(vec2(0.0f, 0.0f));
+    dest.push_back(vec2(0.0f, 0.0f));
+    elapsed.push_back(0.0f);
+    last_action.push_back(0.0f);
+    fade_start.push_back(-1.0f);
+    name_interval.push_back(gGourceSettings.filename_time);
+    file_colour.push_back(vec3(1.0f, 1.0f, 1.0f));
+    touch_colour.push_back(vec3(0.0f, 0.0f, 0.0f));
+    flags.push_back(RFILE_HIDDEN);
+
+    return files.size() - 1;
+}
+
+// files keep their order so their positions around the directory don't change
+void RFileStore::remove(int slot) {
+
+    files.erase(files.begin() + slot);
+
+    pos.erase(pos.begin() + slot);
+    dest.erase(dest.begin() + slot);
+    elapsed.erase(elapsed.begin() + slot);
+    last_action.erase(last_action.begin() + slot);
+    fade_start.erase(fade_start.begin() + slot);
+    name_interval.erase(name_interval.begin() + slot);
+    file_colour.erase(file_colour.begin() + slot);
+    touch_colour.erase(touch_colour.begin() + slot);
+    flags.erase(flags.begin() + slot);
+
+    for(size_t i = slot; i < files.size(); i++) {
+        files[i]->setSlot(i);
+    }
+}
+
+void RFileStore::logic(float dt) {
+
+    size_t count = files.size();
+
+    extent = 0.0f;
+
+    if(count == 0) return;
+
+    float move = std::min(1.0f, RFILE_SPEED * dt);
+
+    float idle_time = gGourceSettings.file_idle_time;
+
+    vec2*  p      = &(pos[0]);
+    const vec2* d = &(dest[0]);
+    float* e      = &(elapsed[0]);
+    float* n      = &(name_interval[0]);
+    const unsigned char* f = &(flags[0]);
+
+    for(size_t i = 0; i < count; i++) {
+        p[i] += (d[i] - p[i]) * move;
+    }
+
+    float extent2 = 0.0f;
+
+    for(size_t i = 0; i < count; i++) {
+        extent2 = std::max(extent2, glm::length2(p[i]));
+    }
+
+    extent = sqrtf(extent2);
+
+    for(size_t i = 0; i < count; i++) {
+        e[i] += dt;
+    }
+
+    // names count down only while the file is visible
+    for(size_t i = 0; i < count; i++) {
+        n[i] = (n[i] > 0.0f && !(f[i] & RFILE_HIDDEN)) ? n[i] - dt : n[i];
+    }
+
+    // changes of state are rare, so they are kept out of the loops above
+    for(size_t i = 0; i < count; i++) {
+
+        if(fade_start[i] < 0.0f && idle_time > 0.0f && (elapsed[i] - last_action[i]) > idle_time) {
+            fade_start[i] = elapsed[i];
+        }
+
+        // has completely faded out
+        if(fade_start[i] > 0.0f && !(flags[i] & RFILE_EXPIRED) && (elapsed[i] - fade_start[i]) >= 1.0f) {
+            flags[i] |= RFILE_EXPIRED;
+            gGourceRemovedFiles.push_back(files[i]);
+        }
+
+        if((flags[i] & (RFILE_HIDDEN | RFILE_FORCED_REMOVAL)) == RFILE_HIDDEN) elapsed[i] = 0.0f;
+    }
+}
+
+// writes a quad for each visible file and returns how many were written.
+// every file's quad is written and hidden files are then overwritten by the
+// next one, so there is space for size() quads.
+
+int RFileStore::fillQuads(quadbuf_vertex* vertices, const vec2& offset, const vec2& dims) const {
+
+    size_t count = files.size();
+
+    vec2 corner_x(dims.x, 0.0f);
+    vec2 corner_y(0.0f, dims.y);
+
+    int written = 0;
+
+    for(size_t i = 0; i < count; i++) {
+
+        float touch = glm::clamp(elapsed[i] - last_action[i], 0.0f, 1.0f);
+
+        vec3 col = touch_colour[i] * (1.0f - touch) + file_colour[i] * touch;
+        col = (flags[i] & RFILE_SELECTED) ? vec3(1.0f) : col;
+
+        float alpha = fade_start[i] > 0.0f
+            ? 1.0f - glm::clamp(elapsed[i] - fade_start[i], 0.0f, 1.0f)
+            : std::min(elapsed[i], 1.0f);
+
+        vec4 colour(col.x, col.y, col.z, alpha);
+        vec2 corner = pos[i] + offset;
+
+        quadbuf_vertex* v = vertices + written * 4;
+
+        v[0] = quadbuf_vertex(corner,            colour, vec2(0.0f, 0.0f));
+        v[1] = quadbuf_vertex(corner + corner_x, colour, vec2(1.0f, 0.0f));
+        v[2] = quadbuf_vertex(corner + dims,     colour, vec2(1.0f, 1.0f));
+        v[3] = quadbuf_vertex(corner + corner_y, colour, vec2(0.0f, 1.0f));
+
+        written += (flags[i] & RFILE_HIDDEN) ? 0 : 1;
+    }
+
+    return written;
+}
@@ -0,0 +1,67 @@
+// === File: src/filestore.h ===================================================
+// AGENT: PURPOSE    — Packed animation state of the files of a directory
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef RFILESTORE_H
+#define RFILESTORE_H
+
+#include "core/vectors.h"
+#include "core/vbo.h"
+
+#include <vector>
+
+class RFile;
+
+enum {
+    RFILE_HIDDEN         = 1,
+    RFILE_SELECTED       = 2,
+    RFILE_REMOVING       = 4,
+    RFILE_EXPIRED        = 8,
+    RFILE_FORCED_REMOVAL = 16
+};
+
+// the per frame state of a directory's files, one array per field and
+// indexed by each file's slot, so files are updated and drawn by linear
+// passes over the arrays. RFile is a handle to its slot which holds the
+// strings and other state only needed occasionally.
+//
+// logic() and fillQuads() are written as separate simple loops over the
+// arrays, without calls or early exits, so the compiler can vectorise them.
+
+class RFileStore {
+public:
+    std::vector<RFile*> files;
+
+    std::vector<vec2>  pos;
+    std::vector<vec2>  dest;
+    std::vector<float> elapsed;
+    std::vector<float> last_action;
+    std::vector<float> fade_start;
+    std::vector<float> name_interval;
+    std::vector<vec3>  file_colour;
+    std::vector<vec3>  touch_colour;
+    std::vector<unsigned char> flags;
+
+    // distance of the furthest file from the directory
+    float extent;
+
+    RFileStore() : extent(0.0f) {};
+
+    size_t size() const { return files.size(); };
+    bool empty() const  { return files.empty(); };
+
+    bool isHidden(int slot) const { return (flags[slot] & RFILE_HIDDEN) != 0; };
+
+    vec3  getColour(int slot) const;
+    float getAlpha(int slot) const;
+
+    int  add(RFile* file);
+    void remove(int slot);
+
+    void logic(float dt);
+
+    int fillQuads(quadbuf_vertex* vertices, const vec2& offset, const vec2& dims) const;
+};
+
+#endif
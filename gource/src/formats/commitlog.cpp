@@ -45,6 +45,10 @@ RCommitLog::RCommitLog(const std::string& logfile, int firstChar) {
     is_dir   = false;
     buffered = false;
 
+    reorder_window = gGourceSettings.reorder_window;
+    reorder_seq    = 0;
+    commit_percent = 0.0f;
+
     if(logfile == "-") {
 
         //check first char
@@ -125,7 +129,7 @@ bool RCommitLog::checkFormat() {
     if(!success) return false;
 
     //read a commit to see if the log is in the correct format
-    if(nextCommit(lastCommit, false)) {
+    if(readCommit(lastCommit, false)) {
 
         if(seekable) {
             //if the log is seekable, go back to the start
@@ -159,7 +163,10 @@ bool RCommitLog::getCommitAt(float percent, RCommit& commit) {
     long currpointer = seeklog->getPointer();
     std::string currlastline = lastline;
 
-    seekTo(percent);
+    // not seekTo(), which would discard commits waiting to be reordered
+    lastline.clear();
+    seeklog->seekTo(percent);
+
     bool success = findNextCommit(commit,500);
 
     //restore settings
@@ -185,6 +192,9 @@ void RCommitLog::seekTo(float percent) {
 
     lastline.clear();
 
+    reorder_queue = std::priority_queue<RReorderedCommit, std::vector<RReorderedCommit>, RReorderedCommitOrder>();
+    reorder_percents.clear();
+
     ((SeekLog*)logf)->seekTo(percent);
 }
 
@@ -199,7 +209,7 @@ bool RCommitLog::findNextCommit(RCommit& commit, int attempts) {
     for(int i=0;i<attempts;i++) {
         RCommit c;
 
-        if(nextCommit(c)) {
+        if(readCommit(c, true)) {
             commit = c;
             return true;
         }
@@ -221,6 +231,15 @@ bool RCommitLog::nextCommit(RCommit& commit, bool validate) {
         return true;
     }
 
+    if(reorder_window > 0) return nextReorderedCommit(commit, validate);
+
+    commit_percent = getPercent();
+
+    return readCommit(commit, validate);
+}
+
+bool RCommitLog::readCommit(RCommit& commit, bool validate) {
+
     // ensure commit is re-initialized
     commit = RCommit();
 
@@ -235,12 +254,48 @@ bool RCommitLog::nextCommit(RCommit& commit, bool validate) {
     return true;
 }
 
-bool RCommitLog::isFinished() {
+// read ahead up to reorder_window commits and return the earliest, so
+// commits that are out of order by less than the window are sorted
+
+bool RCommitLog::nextReorderedCommit(RCommit& commit, bool validate) {
+
+    while(reorder_queue.size() < (size_t) reorder_window && !isLogFinished()) {
+
+        float percent = getPercent();
+
+        RCommit c;
+
+        if(!parseCommit(c)) break;
+
+        c.postprocess();
+
+        if(validate && !c.isValid()) continue;
+
+        reorder_queue.push(RReorderedCommit(c, reorder_seq++, percent));
+        reorder_percents.insert(percent);
+    }
+
+    if(reorder_queue.empty()) return false;
+
+    commit         = reorder_queue.top().commit;
+    commit_percent = reorder_queue.top().percent;
+    reorder_queue.pop();
+
+    reorder_percents.erase(reorder_percents.find(commit_percent));
+
+    return true;
+}
+
+bool RCommitLog::isLogFinished() {
     if(seekable && logf->isFinished()) return true;
 
     return false;
 }
 
+bool RCommitLog::isFinished() {
+    return reorder_queue.empty() && isLogFinished();
+}
+
 bool RCommitLog::hasBufferedCommit() {
     return buffered;
 }
@@ -298,6 +353,7 @@ RCommitFile::RCommitFile(const std::string& filename, const std::string& action,
 
     this->action   = action;
     this->colour   = colour;
+    this->quiet    = false;
 }
 
 RCommit::RCommit() {
@@ -324,27 +380,13 @@ void RCommit::addFile(const std::string& filename, const std::string& action) {
 
 void RCommit::addFile(const std::string& filename, const  std::string& action, const vec3& colour) {
     //check filename against filters
-    if(!gGourceSettings.file_filters.empty()) {
-
-        for(std::vector<Regex*>::iterator ri = gGourceSettings.file_filters.begin(); ri != gGourceSettings.file_filters.end(); ri++) {
-            Regex* r = *ri;
-
-            if(r->match(filename)) {
-                return;
-            }
-        }
+    if(!gGourceSettings.file_filters.empty() && gGourceSettings.file_filters.match(filename)) {
+        return;
     }
 
     // Only allow files that have been whitelisted
-    if(!gGourceSettings.file_show_filters.empty()) {
-
-        for(std::vector<Regex*>::iterator ri = gGourceSettings.file_show_filters.begin(); ri != gGourceSettings.file_show_filters.end(); ri++) {
-            Regex* r = *ri;
-
-            if(!r->match(filename)) {
-                return;
-            }
-        }
+    if(!gGourceSettings.file_show_filters.empty() && !gGourceSettings.file_show_filters.match(filename)) {
+        return;
     }
 
     files.push_back(RCommitFile(filename, action, colour));
@@ -352,33 +394,36 @@ void RCommit::addFile(const std::string& filename, const  std::string& action, c
 
 void RCommit::postprocess() {
     username = RCommitLog::filter_utf8(username);
+
+    if(!gGourceSettings.bot_filters.empty() && (int) files.size() > gGourceSettings.bot_max_files
+        && gGourceSettings.bot_filters.match(username)) {
+        limitFiles(gGourceSettings.bot_max_files);
+    }
 }
 
-bool RCommit::isValid() {
+// mark all but max_files files, spread evenly through the commit, as quiet
 
-    //check user against filters, if found, discard commit
-    if(!gGourceSettings.user_filters.empty()) {
-        for(std::vector<Regex*>::iterator ri = gGourceSettings.user_filters.begin(); ri != gGourceSettings.user_filters.end(); ri++) {
-            Regex* r = *ri;
+void RCommit::limitFiles(int max_files) {
 
-            if(r->match(username)) {
-                return false;
-            }
-        }
-    }
+    size_t count = files.size();
+    size_t i     = 0;
 
-    // Only allow users that have been whitelisted
-    if(!gGourceSettings.user_show_filters.empty()) {
+    for(std::list<RCommitFile>::iterator it = files.begin(); it != files.end(); it++, i++) {
+        it->quiet = (i * max_files) % count >= (size_t) max_files;
+    }
+}
 
-        for(std::vector<Regex*>::iterator ri = gGourceSettings.user_show_filters.begin(); ri != gGourceSettings.user_show_filters.end(); ri++) {
-            Regex* r = *ri;
+bool RCommit::isValid() {
 
-            if(!r->match(username)) {
-                return false;
-            }
-        }
+    //check user against filters, if found, discard commit
+    if(!gGourceSettings.user_filters.empty() && gGourceSettings.user_filters.match(username)) {
+        return false;
     }
 
+    // Only allow users that have been whitelisted
+    if(!gGourceSettings.user_show_filters.empty() && !gGourceSettings.user_show_filters.match(username)) {
+        return false;
+    }
 
     return !files.empty();
 }
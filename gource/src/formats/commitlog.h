@@ -27,6 +27,9 @@
 #include <time.h>
 #include <string>
 #include <list>
+#include <queue>
+#include <set>
+#include <vector>
 
 #include "sys/stat.h"
 
@@ -36,11 +39,15 @@ public:
     std::string action;
     vec3 colour;
 
+    // applied without the user visiting the file
+    bool quiet;
+
     RCommitFile(const std::string& filename, const std::string& action, vec3 colour);
 };
 
 class RCommit {
     vec3 fileColour(const std::string& filename);
+    void limitFiles(int max_files);
 public:
     time_t timestamp;
     std::string username;
@@ -58,6 +65,26 @@ public:
     virtual bool parse(BaseLog* logf) { return false; };
 };
 
+class RReorderedCommit {
+public:
+    RCommit commit;
+    size_t seq;
+    float percent;
+
+    RReorderedCommit(const RCommit& commit, size_t seq, float percent) : commit(commit), seq(seq), percent(percent) {};
+};
+
+// earliest commit first, and commits at the same time in the order read
+
+class RReorderedCommitOrder {
+public:
+    bool operator()(const RReorderedCommit& a, const RReorderedCommit& b) const {
+        if(a.commit.timestamp != b.commit.timestamp) return a.commit.timestamp > b.commit.timestamp;
+
+        return a.seq > b.seq;
+    };
+};
+
 class RCommitLog {
 protected:
     BaseLog* logf;
@@ -74,6 +101,19 @@ protected:
     RCommit lastCommit;
     bool buffered;
 
+    float commit_percent;
+
+    // commits read ahead to be returned in order of time
+    int reorder_window;
+    size_t reorder_seq;
+    std::priority_queue<RReorderedCommit, std::vector<RReorderedCommit>, RReorderedCommitOrder> reorder_queue;
+    std::multiset<float> reorder_percents;
+
+    bool readCommit(RCommit& commit, bool validate);
+    bool nextReorderedCommit(RCommit& commit, bool validate);
+
+    virtual bool isLogFinished();
+
     bool checkFirstChar(int firstChar, std::istream& stream);
 
     bool createTempLog();
@@ -106,6 +146,12 @@ public:
     bool isFinished();
     bool isSeekable();
     float getPercent();
+
+    // position in the log the last commit returned by nextCommit was read from
+    float getCommitPercent() const { return commit_percent; };
+
+    // positions in the log of the commits read ahead but not yet returned
+    const std::multiset<float>& getPendingPercents() const { return reorder_percents; };
 };
 
 #endif
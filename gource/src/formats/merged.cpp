@@ -0,0 +1,99 @@
+// === File: src/formats/merged.cpp ============================================
+// AGENT: PURPOSE    — Commits of several logs merged in order of time
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "merged.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+RMergedCommitLog::RMergedCommitLog() : RCommitLog("") {
+    success = true;
+
+    // each log is reordered as it is read
+    reorder_window = 0;
+}
+
+RMergedCommitLog::~RMergedCommitLog() {
+    for(size_t i=0;i<sources.size();i++) {
+        delete sources[i]->log;
+        delete sources[i];
+    }
+}
+
+// directory named after the last part of a log's path
+
+std::string RMergedCommitLog::getLogName(const std::string& path) {
+
+    fs::path log_path = fs::absolute(fs::path(path)).lexically_normal();
+
+    // trailing slash
+    if(!log_path.has_filename()) log_path = log_path.parent_path();
+
+    std::string name = log_path.filename().string();
+
+    if(name.empty()) name = "log";
+
+    return std::string("/") + name;
+}
+
+// directory the files of a log are shown under, numbered if an earlier
+// log has the same name, skipping numbers another log is already named
+
+std::string RMergedCommitLog::getLogPrefix(const std::string& path) {
+
+    std::string name   = getLogName(path);
+    std::string prefix = name;
+
+    for(int count = 2; prefixes.find(prefix) != prefixes.end(); count++) {
+        prefix = name + std::string("-") + std::to_string(count);
+    }
+
+    prefixes.insert(prefix);
+
+    return prefix;
+}
+
+void RMergedCommitLog::addLog(RCommitLog* log, const std::string& prefix) {
+
+    RMergedLogSource* source = new RMergedLogSource();
+    source->log    = log;
+    source->prefix = prefix;
+    source->index  = sources.size();
+
+    sources.push_back(source);
+
+    if(readNext(source)) queue.push(source);
+}
+
+bool RMergedCommitLog::readNext(RMergedLogSource* source) {
+
+    while(source->log->hasBufferedCommit() || !source->log->isFinished()) {
+        if(source->log->nextCommit(source->commit)) return true;
+    }
+
+    return false;
+}
+
+bool RMergedCommitLog::parseCommit(RCommit& commit) {
+
+    if(queue.empty()) return false;
+
+    RMergedLogSource* source = queue.top();
+    queue.pop();
+
+    commit = source->commit;
+
+    for(std::list<RCommitFile>::iterator it = commit.files.begin(); it != commit.files.end(); it++) {
+        it->filename.insert(0, source->prefix);
+    }
+
+    if(readNext(source)) queue.push(source);
+
+    return true;
+}
+
+bool RMergedCommitLog::isLogFinished() {
+    return queue.empty();
+}
@@ -0,0 +1,61 @@
+// === File: src/formats/merged.h ==============================================
+// AGENT: PURPOSE    — Commits of several logs merged in order of time
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef MERGEDLOG_H
+#define MERGEDLOG_H
+
+#include "commitlog.h"
+
+#include <queue>
+#include <vector>
+#include <set>
+
+class RMergedLogSource {
+public:
+    RCommitLog* log;
+    std::string prefix;
+    size_t index;
+
+    // the next commit of this log
+    RCommit commit;
+};
+
+// earliest commit first, and for commits at the same time the order
+// the logs were added in
+
+class RMergedLogOrder {
+public:
+    bool operator()(const RMergedLogSource* a, const RMergedLogSource* b) const {
+        if(a->commit.timestamp != b->commit.timestamp) return a->commit.timestamp > b->commit.timestamp;
+
+        return a->index > b->index;
+    };
+};
+
+// merges the commits of seekable logs in order of time, prefixing the
+// paths of each log's files with a directory for the log. each log is
+// read a commit at a time, the heap only holds the next commit of each.
+
+class RMergedCommitLog : public RCommitLog {
+    std::vector<RMergedLogSource*> sources;
+    std::priority_queue<RMergedLogSource*, std::vector<RMergedLogSource*>, RMergedLogOrder> queue;
+
+    std::set<std::string> prefixes;
+
+    bool readNext(RMergedLogSource* source);
+protected:
+    bool parseCommit(RCommit& commit);
+    bool isLogFinished();
+public:
+    RMergedCommitLog();
+    ~RMergedCommitLog();
+
+    static std::string getLogName(const std::string& path);
+    std::string getLogPrefix(const std::string& path);
+
+    void addLog(RCommitLog* log, const std::string& prefix);
+};
+
+#endif
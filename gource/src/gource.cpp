@@ -52,6 +52,9 @@ Gource::Gource(FrameExporter* exporter) {
         gGourceSettings.setScaledFontSizes();
     }
 
+    //buffered labels are drawn by the text shader
+    fontmanager.use_sdf = gGourceSettings.sdf_fonts && !gGourceSettings.ffp;
+
     fontlarge = fontmanager.grab(gGourceSettings.font_file, 42 * gGourceSettings.font_scale);
     fontlarge.dropShadow(true);
     fontlarge.roundCoordinates(true);
@@ -133,6 +136,13 @@ Gource::Gource(FrameExporter* exporter) {
 
     frameExporter = 0;
 
+    //render output larger than the window or supersampled in offscreen tiles
+    tiled_render = 0;
+
+    if(gGourceSettings.output_scale > 1 || gGourceSettings.output_supersample > 1) {
+        tiled_render = new TiledRender(gGourceSettings.output_scale, gGourceSettings.output_supersample);
+    }
+
     dirNodeTree = 0;
     userTree = 0;
 
@@ -163,6 +173,9 @@ Gource::Gource(FrameExporter* exporter) {
     frameskip = 0;
     framecount = 0;
 
+    output_segment_start = 0;
+    output_segment_end   = 0;
+
     reset();
 
     logmill = new RLogMill(logfile);
@@ -224,6 +237,8 @@ Gource::~Gource() {
     if(logmill!=0)   delete logmill;
     if(root!=0)      delete root;
 
+    if(tiled_render!=0) delete tiled_render;
+
     //reset settings
     gGourceSettings.setGourceDefaults();
 }
@@ -248,6 +263,20 @@ void Gource::reload() {
 void Gource::quit() {
 }
 
+void Gource::step(float scaled_dt) {
+
+    //have to manage runtime internally as we're messing with dt
+    if(!paused) runtime += scaled_dt;
+
+    if(gGourceSettings.stop_at_time > 0.0 && runtime >= gGourceSettings.stop_at_time) stop_position_reached = true;
+
+    logic_time = SDL_GetTicks();
+
+    logic(runtime, scaled_dt);
+
+    logic_time = SDL_GetTicks() - logic_time;
+}
+
 void Gource::update(float t, float dt) {
 
     float scaled_dt = std::min(dt, max_tick_rate);
@@ -260,26 +289,57 @@ void Gource::update(float t, float dt) {
     //apply time scaling
     scaled_dt *= gGourceSettings.time_scale;
 
-    //have to manage runtime internally as we're messing with dt
-    if(!paused) runtime += scaled_dt;
+    //frames that will not be exported only need the simulation updated,
+    //so run them as logic only ticks ahead of the next exported frame.
+    //frames before this process's output segment are counted but not exported
+    if(frameExporter != 0) {
+        Uint32 warmup_ticks = SDL_GetTicks();
 
-    if(gGourceSettings.stop_at_time > 0.0 && runtime >= gGourceSettings.stop_at_time) stop_position_reached = true;
+        while(commitlog && !gGourceSettings.shutdown && !appFinished) {
 
-    logic_time = SDL_GetTicks();
+            if(framecount % (frameskip+1) == 0) {
+                if(output_segment_start == 0 || currtime >= output_segment_start) break;
 
-    logic(runtime, scaled_dt);
+                //continue fast forwarding on the next update
+                if(SDL_GetTicks() - warmup_ticks >= GOURCE_SEGMENT_WARMUP_MSEC) return;
 
-    logic_time = SDL_GetTicks() - logic_time;
+                frameExporter->skipFrame();
+            }
+
+            step(scaled_dt);
+            framecount++;
+        }
+
+        //the next segment starts here
+        if(output_segment_end != 0 && currtime >= output_segment_end) {
+            appFinished = true;
+            return;
+        }
+    }
+
+    step(scaled_dt);
 
     draw(runtime, scaled_dt);
 
     //extract frames based on frameskip setting if frameExporter defined
     if(frameExporter != 0 && commitlog && !gGourceSettings.shutdown) {
         if(framecount % (frameskip+1) == 0) {
-            frameExporter->dump();
+            TileRowWriter* tile_writer = tiled_render != 0 ? frameExporter->getTileWriter() : 0;
+
+            if(tile_writer != 0) {
+                drawTiled(runtime, *tile_writer);
+            } else {
+                frameExporter->dump();
+            }
         }
     }
 
+    //tiled screenshots are rendered once the frame is complete
+    if(take_screenshot && tiled_render != 0) {
+        screenshot();
+        take_screenshot = false;
+    }
+
     if(!gGourceSettings.hide_mouse) {
         //note: cursor uses real dt
         cursor.logic(dt);
@@ -289,23 +349,64 @@ void Gource::update(float t, float dt) {
     framecount++;
 }
 
+// split the time span of the log into equal parts, exporting only the frames
+// of one of them. every process runs the simulation from the start of the log
+// so frames at the boundaries match those of a single export.
+
+void Gource::initOutputSegment() {
+
+    time_t first = 0, last = 0;
+
+    if(!logmill->getActivityIndex().getTimeRange(first, last)) {
+        throw SDLAppException("output segments require a seekable log");
+    }
+
+    if(gGourceSettings.start_timestamp != 0) first = std::max(first, gGourceSettings.start_timestamp);
+    if(gGourceSettings.stop_timestamp  != 0) last  = std::min(last,  gGourceSettings.stop_timestamp);
+
+    double span = (double) (last - first);
+
+    int index = gGourceSettings.output_segment_index;
+    int count = gGourceSettings.output_segment_count;
+
+    if(index > 1)     output_segment_start = first + (time_t) (span * (index-1) / count);
+    if(index < count) output_segment_end   = first + (time_t) (span * index / count);
+
+    //later segments are appended to the output of the first
+    if(index > 1 && frameExporter != 0) frameExporter->continueStream();
+}
+
 //peek at the date under the mouse pointer on the slider
 std::string Gource::dateAtPosition(float percent) {
 
-    RCommit commit;
     std::string date;
 
-    if(percent<1.0 && commitlog->getCommitAt(percent, commit)) {
-        //display date
-        char datestr[256];
+    if(percent>=1.0) return date;
 
-        // TODO: memory leak ??
-        struct tm* timeinfo = localtime ( &(commit.timestamp) );
-        strftime(datestr, 256, "%A, %d %B, %Y", timeinfo);
+    time_t timestamp;
 
-        date = std::string(datestr);
+    const RActivityIndex& activity = logmill->getActivityIndex();
+
+    //use the activity index if available rather than reading the log
+    if(activity.isComplete()) {
+        if(!activity.getTimestampAt(percent, timestamp)) return date;
+    } else {
+        RCommit commit;
+
+        if(!commitlog->getCommitAt(percent, commit)) return date;
+
+        timestamp = commit.timestamp;
     }
 
+    //display date
+    char datestr[256];
+
+    // TODO: memory leak ??
+    struct tm* timeinfo = localtime ( &timestamp );
+    strftime(datestr, 256, "%A, %d %B, %Y", timeinfo);
+
+    date = std::string(datestr);
+
     return date;
 }
 
@@ -938,6 +1039,7 @@ void Gource::reset() {
     }
 
     users.clear();
+    avatars.clear();
 
     //delete
     for(std::map<std::string,RFile*>::iterator it = files.begin(); it != files.end(); it++) {
@@ -964,14 +1066,13 @@ void Gource::reset() {
     currtime=0;
     lasttime=0;
     subseconds=0.0;
+    time_warp=1.0;
     tag_seq = 1;
     commit_seq = 1;
 }
 
 void Gource::deleteFile(RFile* file) {
-    //debugLog("removing file %s\n", file->fullpath.c_str());
-
-    root->removeFile(file);
+    //debugLog("removing file %s\n", file->getFullPath().c_str());
 
     if(hoverFile == file) {
         hoverFile = 0;
@@ -982,16 +1083,21 @@ void Gource::deleteFile(RFile* file) {
     }
 
     //remove from any users with actions against this file - wrong way around? meh
+    //users find the actions by the file's directory and place in it, so this
+    //has to happen before the file is removed from the tree
     for(std::map<std::string,RUser*>::iterator it = users.begin(); it!=users.end(); it++) {
         RUser* user = it->second;
 
         user->fileRemoved(file);
     }
 
-    files.erase(file->fullpath);
+    //the file's state is held by its directory until it is removed from it
+    root->removeFile(file);
+
+    files.erase(file->getFullPath());
     file_key.dec(file);
 
-    //debugLog("removed file %s\n", file->fullpath.c_str());
+    //debugLog("removed file %s\n", file->getFullPath().c_str());
 
     delete file;
 }
@@ -1011,12 +1117,14 @@ RFile* Gource::addFile(const RCommitFile& cf) {
 
     int tagid = tag_seq++;
 
-    RFile* file = new RFile(cf.filename, cf.colour, vec2(0.0,0.0), tagid);
+    RFile* file = new RFile(cf.filename, tagid);
 
     files[cf.filename] = file;
 
     root->addFile(file);
 
+    file->setFileColour(cf.colour);
+
     file_key.inc(file);
 
     while(root->getParent() != 0) {
@@ -1041,6 +1149,10 @@ RUser* Gource::addUser(const std::string& username) {
 
     RUser* user = new RUser(username, pos, tagid);
 
+    if(!user->getPendingImage().empty()) {
+        avatars.request(user, user->getPendingImage());
+    }
+
     users[username]   = user;
     tagusermap[tagid] = user;
 
@@ -1062,6 +1174,8 @@ void Gource::deleteUser(RUser* user) {
     users.erase(user->getName());
     tagusermap.erase(user->getTagID());
 
+    avatars.cancel(user);
+
     //debugLog("deleted user %s, tagid = %d\n", user->getName().c_str(), user->getTagID());
 
     delete user;
@@ -1073,6 +1187,11 @@ bool Gource::canSeek() {
     return true;
 }
 
+// speed multiplier applied to days-per-second by the time warp
+float Gource::getTimeWarp() const {
+    return time_warp;
+}
+
 void Gource::seekTo(float percent) {
     //debugLog("seekTo(%.2f)\n", percent);
 
@@ -1083,6 +1202,9 @@ void Gource::seekTo(float percent) {
 
     reset();
 
+    //before the seek discards the commits read ahead to be reordered
+    logmill->getActivityIndex().seekTo(percent, commitlog->getPendingPercents());
+
     commitlog->seekTo(percent);
 }
 
@@ -1142,6 +1264,8 @@ void Gource::readLog() {
 
     //debugLog("readLog()\n");
 
+    RActivityIndex& activity = logmill->getActivityIndex();
+
     // read commits until either we are ahead of currtime
     while((commitlog->hasBufferedCommit() || !commitlog->isFinished()) && (commitqueue.empty() || (commitqueue.back().timestamp <= currtime && commitqueue.size() < commitqueue_max_size)) ) {
 
@@ -1154,6 +1278,10 @@ void Gource::readLog() {
             continue;
         }
 
+        if(commitlog->isSeekable()) {
+            activity.record(commitlog->getCommitPercent(), commit);
+        }
+
         if(gGourceSettings.stop_timestamp != 0 && commit.timestamp > gGourceSettings.stop_timestamp) {
             stop_position_reached = true;
             break;
@@ -1175,6 +1303,9 @@ void Gource::readLog() {
 
     bool is_finished = commitlog->isFinished();
 
+    if(is_finished && commitlog->isSeekable()) {
+        activity.finish();
+    }
 
     if(
        // end reached
@@ -1196,6 +1327,12 @@ void Gource::readLog() {
 
 void Gource::processCommit(const RCommit& commit, float t) {
 
+    //large commits only show one action per directory, the other
+    //files are changed without the user visiting them
+    bool bulk = gGourceSettings.bulk_commit_files > 0 && commit.files.size() > (size_t) gGourceSettings.bulk_commit_files;
+
+    std::set<RDirNode*> action_dirs;
+
     //find files of this commit or create it
     for(std::list<RCommitFile>::const_iterator it = commit.files.begin(); it != commit.files.end(); it++) {
 
@@ -1230,7 +1367,9 @@ void Gource::processCommit(const RCommit& commit, float t) {
                 for(std::list<RFile*>::iterator it = dir_files.begin(); it != dir_files.end(); it++) {
                     RFile* file = *it;
 
-                    addFileAction(commit, cf, file, t);
+                    bool quiet = bulk && !action_dirs.insert(file->getDir()).second;
+
+                    addFileAction(commit, cf, file, t, quiet);
                 }
             }
 
@@ -1246,11 +1385,13 @@ void Gource::processCommit(const RCommit& commit, float t) {
             if(!file) continue;
         }
 
-        addFileAction(commit, cf, file, t);
+        bool quiet = bulk && !action_dirs.insert(file->getDir()).second;
+
+        addFileAction(commit, cf, file, t, quiet);
     }
 }
 
-void Gource::addFileAction(const RCommit& commit, const RCommitFile& cf, RFile* file, float t) {
+void Gource::addFileAction(const RCommit& commit, const RCommitFile& cf, RFile* file, float t, bool quiet) {
     //create user if havent yet. do it here to ensure at least one of there files
     //was added (incase we hit gGourceSettings.max_files)
 
@@ -1295,6 +1436,13 @@ void Gource::addFileAction(const RCommit& commit, const RCommitFile& cf, RFile*
         }
     }
 
+    //files of bulk commits and bot commits beyond those shown
+    if(quiet || cf.quiet) {
+        userAction->finish();
+        delete userAction;
+        return;
+    }
+
     user->addAction(userAction);
 }
 
@@ -1496,7 +1644,7 @@ void Gource::updateCamera(float dt) {
 
             vec3 cam_pos = camera.getPos();
 
-            vec2 cursor_delta = cursor_move * cam_rate * 10.0f;
+            vec2 cursor_delta = camera.viewToWorld(cursor_move * cam_rate * 10.0f);
 
             cam_pos.x += cursor_delta.x;
             cam_pos.y += cursor_delta.y;
@@ -1547,7 +1695,9 @@ void Gource::updateCamera(float dt) {
 
             float aspect_ratio = display.width / (float) display.height;
 
-            float bounds_ratio = (aspect_ratio > 1.0f) ? dir_bounds.width() / dir_bounds.height() : dir_bounds.height() / dir_bounds.width();
+            vec2 view_dims = camera.getViewDimensions(dir_bounds);
+
+            float bounds_ratio = (aspect_ratio > 1.0f) ? view_dims.x / view_dims.y : view_dims.y / view_dims.x;
 
             if(bounds_ratio < 0.67f) {
                 rotation_remaining_angle = 90.0f;
@@ -1558,6 +1708,20 @@ void Gource::updateCamera(float dt) {
     }
 }
 
+//check which directories are on screen and collapse those whose files are
+//too small to see. this is decided from the camera as part of the logic, so
+//the simulation of collapsed directories does not depend on what is drawn
+
+void Gource::updateVisibility() {
+
+    Frustum frustum(camera.getPos(), camera.getTarget(), camera.getUp(), camera.getFOV(), camera.getZNear(), camera.getZFar());
+
+    //size of a unit at the file plane on screen, used to choose the level of detail
+    float pixels_per_unit = display.height / (tan(camera.getFOV() * 0.5f * DEGREES_TO_RADIANS) * 2.0f * -camera.getPos().z);
+
+    root->checkFrustum(frustum, pixels_per_unit);
+}
+
 //change the string hashing seed and recolour files and users
 void Gource::changeColours() {
 
@@ -1610,6 +1774,12 @@ void Gource::logic(float t, float dt) {
             }
         }
 
+        slider.setActivity(&logmill->getActivityIndex());
+
+        if(gGourceSettings.output_segment_count > 1) {
+            initOutputSegment();
+        }
+
         if(gGourceSettings.start_position>0.0) {
             seekTo(gGourceSettings.start_position);
         }
@@ -1662,34 +1832,7 @@ void Gource::logic(float t, float dt) {
 
     //apply rotation
     if(rotate_angle != 0.0f) {
-
-        float s = sinf(rotate_angle);
-        float c = cosf(rotate_angle);
-
-        if(manual_rotate) {
-            // rotate around camera position if manual
-            vec2 centre = vec2(camera.getPos());
-
-            root->rotate(s, c, centre);
-
-            for(std::map<std::string,RUser*>::iterator it = users.begin(); it!=users.end(); it++) {
-                RUser* user = it->second;
-
-                vec2 rotated_user_pos = rotate_vec2(user->getPos() - centre, s, c) + centre;
-                user->setPos(rotated_user_pos);
-            }
-        } else {
-            root->rotate(s, c);
-
-            for(std::map<std::string,RUser*>::iterator it = users.begin(); it!=users.end(); it++) {
-                RUser* user = it->second;
-
-                vec2 rotated_user_pos = rotate_vec2(user->getPos(), s, c);
-                user->setPos(rotated_user_pos);
-            }
-
-        }
-
+        camera.rotate(rotate_angle);
         rotate_angle = 0.0f;
     }
 
@@ -1704,6 +1847,7 @@ void Gource::logic(float t, float dt) {
         interactUsers();
         interactDirs();
         updateCamera(dt);
+        updateVisibility();
         return;
     }
 
@@ -1728,8 +1872,13 @@ void Gource::logic(float t, float dt) {
         loadCaptions();
     }
 
+    //vary the speed with the activity around the current time
+    if(gGourceSettings.time_warp) {
+        time_warp = logmill->getActivityIndex().getTimeWarp(currtime, gGourceSettings.time_warp_min, gGourceSettings.time_warp_max);
+    }
+
     //set current time
-    float time_inc = (dt * 86400.0 * gGourceSettings.days_per_second);
+    float time_inc = (dt * 86400.0 * gGourceSettings.days_per_second * time_warp);
     int seconds    = (int) time_inc;
 
     subseconds += time_inc - ((float) seconds);
@@ -1782,6 +1931,13 @@ void Gource::logic(float t, float dt) {
         commitqueue.pop_front();
     }
 
+    //recorded frames must show user images from the start
+    if(frameExporter != 0) {
+        avatars.finish();
+    } else {
+        avatars.upload(GOURCE_AVATAR_UPLOADS_PER_FRAME);
+    }
+
     slider.resize();
 
     float caption_height  = fontcaption.getMaxHeight();
@@ -1882,6 +2038,7 @@ void Gource::logic(float t, float dt) {
     updateDirs(dt);
 
     updateCamera(dt);
+    updateVisibility();
 
     updateTime(!commitqueue.empty() ? currtime : lasttime);
 }
@@ -1893,6 +2050,9 @@ void Gource::mousetrace(float dt) {
     vec2 projected_mouse = vec2( -(mousepos.x * 2.0f - ((float)display.width)) / ((float)display.height),
                                    (1.0f - (2.0f * mousepos.y) / ((float)display.height)))
                                    * cam_pos.z;
+
+    projected_mouse = camera.viewToWorld(projected_mouse);
+
     projected_mouse.x += cam_pos.x;
     projected_mouse.y += cam_pos.y;
 
@@ -1927,9 +2087,11 @@ void Gource::mousetrace(float dt) {
 
             RDirNode* dir = (RDirNode*) *it;
 
-            const std::list<RFile*>* files = dir->getFiles();
+            if(dir->isCollapsed()) continue;
+
+            const std::vector<RFile*>* files = dir->getFiles();
 
-            for(std::list<RFile*>::const_iterator fi = files->begin(); fi != files->end(); fi++) {
+            for(std::vector<RFile*>::const_iterator fi = files->begin(); fi != files->end(); fi++) {
 
                 RFile* file = *fi;
 
@@ -2263,11 +2425,37 @@ void Gource::screenshot() {
     std::string filename(pngname);
 
     PNGWriter png(gGourceSettings.transparent ? 4 : 3);
-    png.screenshot(filename);
+
+    if(tiled_render != 0) {
+        if(png.open(filename)) {
+            drawTiled(runtime, png);
+            png.close();
+        }
+    } else {
+        png.screenshot(filename);
+    }
 
     setMessage("Wrote screenshot %s", pngname);
 }
 
+// draw the current frame again into each tile of the output image.
+// the frame has already been drawn, so animations are not advanced.
+
+void Gource::drawTiled(float t, TileRowWriter& writer) {
+
+    if(!tiled_render->begin(writer)) return;
+
+    int tile_count = tiled_render->getTileCount();
+
+    for(int i=0;i<tile_count;i++) {
+        tiled_render->beginTile(i);
+        draw(t, 0.0f);
+        tiled_render->endTile(i);
+    }
+
+    tiled_render->end();
+}
+
 void Gource::updateVBOs(float dt) {
     if(gGourceSettings.ffp) return;
 
@@ -2326,8 +2514,10 @@ void Gource::drawFileShadows(float dt) {
 
         glBindTexture(GL_TEXTURE_2D, gGourceSettings.file_graphic->textureid);
 
+        vec2 shadow_offset = camera.viewToWorld(vec2(2.0, 2.0));
+
         r.pushModelView();
-        r.translateMV(2.0f, 2.0f, 0.0f);
+        r.translateMV(shadow_offset.x, shadow_offset.y, 0.0f);
 
         // Set MVP matrix for shadow shader
         GLint mvp_loc = shadow_shader->getUniformLocation("u_mvp");
@@ -2359,7 +2549,7 @@ void Gource::drawUserShadows(float dt) {
         shadow_shader->setFloat("u_shadow_strength", 0.5);
         shadow_shader->use();
 
-        vec2 shadow_offset = vec2(2.0, 2.0) * gGourceSettings.user_scale;
+        vec2 shadow_offset = camera.viewToWorld(vec2(2.0, 2.0) * gGourceSettings.user_scale);
 
         r.pushModelView();
         r.translateMV(shadow_offset.x, shadow_offset.y, 0.0f);
@@ -2441,8 +2631,6 @@ void Gource::draw(float t, float dt) {
         return;
     }
 
-    Frustum frustum(camera.getPos(), camera.getTarget(), camera.getUp(), camera.getFOV(), camera.getZNear(), camera.getZFar());
-
     trace_time = SDL_GetTicks();
 
     if(!gGourceSettings.hide_mouse && cursor.isVisible()) {
@@ -2465,9 +2653,6 @@ void Gource::draw(float t, float dt) {
 
     camera.focus();
 
-    //check visibility
-    root->checkFrustum(frustum);
-
     screen_project_time = SDL_GetTicks();
 
     GLint viewport[4];
@@ -2490,8 +2675,8 @@ void Gource::draw(float t, float dt) {
     }
 
     //need to calc screen pos of selected file if hiding other
-    //file names
-    if(selectedFile!=0 && gGourceSettings.hide_filenames) {
+    //file names or its directory is collapsed
+    if(selectedFile!=0 && (gGourceSettings.hide_filenames || selectedFile->getDir()->isCollapsed())) {
         selectedFile->calcScreenPos(viewport, modelview, projection);
     }
 
@@ -2531,7 +2716,13 @@ void Gource::draw(float t, float dt) {
     fontdirname.roundCoordinates(false);
     fontdirname.setColour(vec4(gGourceSettings.dir_colour, 1.0f));
 
-    root->drawNames(fontdirname);
+    if(gGourceSettings.disable_label_culling) {
+        root->drawNames(fontdirname);
+    } else {
+        label_grid.reset(display.width, display.height);
+        root->queueNames(label_grid, fontdirname);
+        label_grid.draw(fontdirname);
+    }
 
    if(!(gGourceSettings.hide_usernames || gGourceSettings.hide_users)) {
         for(std::map<std::string,RUser*>::iterator it = users.begin(); it!=users.end(); it++) {
@@ -2560,6 +2751,7 @@ void Gource::draw(float t, float dt) {
         text_shader->setSampler2D("u_texture", 0);
         text_shader->setFloat("u_shadow_strength", 0.7);
         text_shader->setFloat("u_texel_size", font_texel_size);
+        text_shader->setBool("u_sdf", fontmanager.use_sdf);
         text_shader->use();
 
         // Set MVP matrix for text shader
@@ -2716,7 +2908,7 @@ void Gource::draw(float t, float dt) {
     //text box
     if(hoverFile && hoverFile != selectedFile) {
 
-        std::string display_path = hoverFile->path;
+        std::string display_path = hoverFile->getPath();
         display_path.erase(0,1);
 
         textbox.setText(hoverFile->getName());
@@ -2744,8 +2936,8 @@ void Gource::draw(float t, float dt) {
         glEnable(GL_TEXTURE_2D);
 
         font.print(1,20, "FPS: %.2f", fps);
-        font.print(1,40,"Days Per Second: %.2f",
-            gGourceSettings.days_per_second);
+        font.print(1,40,"Days Per Second: %.2f (x%.2f)",
+            gGourceSettings.days_per_second, time_warp);
         font.print(1,60,"Commit Queue: %d", commitqueue.size());
         font.print(1,80,"Users: %d", users.size());
         font.print(1,100,"Files: %d", files.size());
@@ -2766,7 +2958,11 @@ void Gource::draw(float t, float dt) {
         font.print(1,360," - Users: %u ms",   draw_users_time);
         font.print(1,380," - Bloom: %u ms",   draw_bloom_time);
         font.print(1,400,"Text: %u ms",       text_time);
-        font.print(1,420,"- Update: %u ms",   text_update_time);
+        if(gGourceSettings.disable_label_culling) {
+            font.print(1,420,"- Update: %u ms", text_update_time);
+        } else {
+            font.print(1,420,"- Update: %u ms (%d/%d labels)", text_update_time, (int) label_grid.getDrawnCount(), (int) label_grid.getLabelCount());
+        }
         font.print(1,440,"- VBO Commit: %u ms", text_vbo_commit_time);
         font.print(1,460,"- VBO Draw: %u ms",   text_vbo_draw_time);
         font.print(1,480,"Mouse Trace: %u ms", trace_time);
@@ -2802,7 +2998,7 @@ void Gource::draw(float t, float dt) {
     mousemoved=false;
     mouseclicked=false;
 
-    if(take_screenshot) {
+    if(take_screenshot && tiled_render == 0) {
         screenshot();
         take_screenshot = false;
     }
@@ -31,6 +31,7 @@
 #include "core/frustum.h"
 #include "core/regex.h"
 #include "core/ppm.h"
+#include "core/tiled_render.h"
 #include "core/mousecursor.h"
 
 #include "gource_settings.h"
@@ -45,15 +46,22 @@
 #include "caption.h"
 #include "file.h"
 #include "user.h"
+#include "avatars.h"
 #include "dirnode.h"
 #include "zoomcamera.h"
 #include "key.h"
 
+// time in milliseconds spent fast forwarding to the start of an output
+// segment before returning to the main loop, so events are still handled
+#define GOURCE_SEGMENT_WARMUP_MSEC 100
+
 class Gource : public SDLApp {
     std::string logfile;
 
     FrameExporter* frameExporter;
 
+    TiledRender* tiled_render;
+
     RLogMill* logmill;
 
     RCommitLog* commitlog;
@@ -62,6 +70,8 @@ class Gource : public SDLApp {
 
     FileKey file_key;
 
+    RAvatarLoader avatars;
+
     bool debug, trace_debug;
 
     bool manual_zoom;
@@ -113,6 +123,8 @@ class Gource : public SDLApp {
 
     RDirNode* root;
 
+    RLabelGrid label_grid;
+
     std::string displaydate;
     int date_x_offset;
 
@@ -142,10 +154,14 @@ class Gource : public SDLApp {
     int frameskip;
     int framecount;
 
+    time_t output_segment_start;
+    time_t output_segment_end;
+
     time_t currtime;
     time_t lasttime;
     float runtime;
     float subseconds;
+    float time_warp;
 
     float splash;
 
@@ -214,13 +230,14 @@ class Gource : public SDLApp {
     void logReadingError(const std::string& error);
 
     void processCommit(const RCommit& commit, float t);
-    void addFileAction(const RCommit& commit, const RCommitFile& cf, RFile* file, float t);
+    void addFileAction(const RCommit& commit, const RCommitFile& cf, RFile* file, float t, bool quiet = false);
 
     std::string dateAtPosition(float percent);
 
     void toggleCameraMode();
 
     void updateCamera(float dt);
+    void updateVisibility();
 
     void updateUsers(float t, float dt);
     void updateDirs(float dt);
@@ -232,6 +249,10 @@ class Gource : public SDLApp {
 
     void updateTime(time_t display_time);
 
+    void step(float scaled_dt);
+
+    void initOutputSegment();
+
     void mousetrace(float dt);
 
     bool canSeek();
@@ -257,6 +278,8 @@ class Gource : public SDLApp {
 
     void screenshot();
 
+    void drawTiled(float t, TileRowWriter& writer);
+
     void changeColours();
 
     void grabMouse(bool grab_mouse);
@@ -274,6 +297,8 @@ public:
 
     bool isBusy();
 
+    float getTimeWarp() const;
+
     void logic(float t, float dt);
     void draw(float t, float dt);
 
@@ -28,8 +28,6 @@
 #include <cctype>
 #include <sstream>
 
-#include "core/utf8/utf8.h"
-
 namespace fs = std::filesystem;
 #include <time.h>
 
@@ -83,6 +81,9 @@ void GourceSettings::help(bool extended_help) {
     printf("      --disable-auto-skip          Disable auto skip\n");
     printf("  -s, --seconds-per-day SECONDS    Speed in seconds per day (default: 10)\n");
     printf("      --realtime                   Realtime playback speed\n");
+    printf("      --time-warp                  Vary the speed with the amount of activity\n");
+    printf("      --time-warp-min SCALE        Slowest speed of busy periods (default: 0.25)\n");
+    printf("      --time-warp-max SCALE        Fastest speed of quiet periods (default: 16)\n");
     printf("      --no-time-travel             Use the time of the last commit if the\n");
     printf("                                   time of a commit is in the past\n");
     printf("      --author-time                Use the timestamp of the author instead of\n");
@@ -101,16 +102,26 @@ void GourceSettings::help(bool extended_help) {
     printf("  --file-idle-time-at-end SECONDS  Time files remain idle at end (default: 0)\n\n");
 
     printf("  --max-files NUMBER      Max number of files or 0 for no limit\n");
-    printf("  --max-file-lag SECONDS  Max time files of a commit can take to appear\n\n");
+    printf("  --max-file-lag SECONDS  Max time files of a commit can take to appear\n");
+    printf("  --dir-lod-files NUMBER  Draw directories with this many files as a single\n");
+    printf("                          disc when small or off screen (default: 1000)\n");
+    printf("  --bulk-commit-files NUMBER\n");
+    printf("                          Show commits of more files as one action per\n");
+    printf("                          directory (default: 1000)\n\n");
 
     printf("  --log-command VCS       Show the VCS log command (git,svn,hg,bzr,cvs2cl)\n");
-    printf("  --log-format  VCS       Specify the log format (git,svn,hg,bzr,cvs2cl,custom)\n\n");
+    printf("  --log-format  VCS       Specify the log format (git,svn,hg,bzr,cvs2cl,custom)\n");
+    printf("  --merge-repo  PATH      Show this repository or log as well, merged by time\n");
+    printf("  --reorder-window NUMBER Sort commits out of order by less than this many\n");
+    printf("                          commits (default: 0)\n\n");
 
     printf("  --load-config CONF_FILE  Load a config file\n");
     printf("  --save-config CONF_FILE  Save a config file with the current options\n\n");
 
     printf("  -o, --output-ppm-stream FILE    Output PPM stream to a file ('-' for STDOUT)\n");
-    printf("  -r, --output-framerate  FPS     Framerate of output (25,30,60)\n\n");
+    printf("  -r, --output-framerate  FPS     Framerate of output (25,30,60)\n");
+    printf("      --output-format FORMAT      Format of output (ppm,y4m,png)\n");
+    printf("      --output-segment INDEX/COUNT Output part INDEX of COUNT of the timeline\n\n");
 
 if(extended_help) {
     printf("Extended Options:\n\n");
@@ -118,6 +129,12 @@ if(extended_help) {
     printf("  --window-position XxY    Initial window position\n");
     printf("  --frameless              Frameless window\n\n");
 
+    printf("  --output-scale SCALE           Render output at SCALE times the window size\n");
+    printf("  --output-supersample FACTOR    Supersample output by FACTOR in each direction\n");
+    printf("  --output-threads NUMBER        PNG compression threads (default: number of CPUs)\n");
+    printf("  --output-png-compression LEVEL PNG compression level (0-9)\n");
+    printf("  --output-png-filter FILTER     PNG row filter (none,sub,up,avg,paeth,all)\n\n");
+
     printf("  --output-custom-log FILE  Output a custom format log file ('-' for STDOUT).\n\n");
 
     printf("  -b, --background-colour  FFFFFF    Background colour in hex\n");
@@ -134,10 +151,13 @@ if(extended_help) {
 
     printf("  --disable-input          Disable keyboard and mouse input\n\n");
 
+    printf("  --disable-label-culling  Draw all names, even where they overlap\n\n");
+
     printf("  --date-format FORMAT     Specify display date string (strftime format)\n\n");
 
     printf("  --font-file FILE         Specify the font\n");
     printf("  --font-scale SCALE       Scale the size of all fonts\n");
+    printf("  --sdf-fonts              Draw labels from a distance field atlas\n");
     printf("  --font-size SIZE         Font size used by date and title\n");
     printf("  --file-font-size SIZE    Font size for filenames\n");
     printf("  --dir-font-size SIZE     Font size for directory names\n");
@@ -164,6 +184,9 @@ if(extended_help) {
 
     printf("  --user-filter REGEX      Ignore usernames matching this regex\n");
     printf("  --user-show-filter REGEX Show only usernames matching this regex\n\n");
+    printf("  --bot-filter REGEX       Limit the files shown changing per commit for\n");
+    printf("                           usernames matching this regex\n");
+    printf("  --bot-max-files NUMBER   Files shown changing per bot commit (default: 10)\n\n");
     printf("  --file-filter REGEX      Ignore file paths matching this regex\n");
     printf("  --file-show-filter REGEX Show only file paths matching this regex\n\n");
 
@@ -216,7 +239,8 @@ if(extended_help) {
     exit(0);
 }
 
-GourceSettings::GourceSettings() {
+GourceSettings::GourceSettings()
+    : file_show_filters(true), user_show_filters(true) {
     repo_count = 0;
     file_graphic = 0;
     log_level = LOG_LEVEL_OFF;
@@ -267,6 +291,7 @@ GourceSettings::GourceSettings() {
     arg_types["loop"]                    = "bool";
     arg_types["realtime"]                = "bool";
     arg_types["no-time-travel"]          = "bool";
+    arg_types["time-warp"]               = "bool";
     arg_types["colour-images"]           = "bool";
     arg_types["hide-date"]               = "bool";
     arg_types["hide-files"]              = "bool";
@@ -287,10 +312,12 @@ GourceSettings::GourceSettings() {
     arg_types["author-time"]             = "bool";
     arg_types["key"]                     = "bool";
     arg_types["ffp"]                     = "bool";
+    arg_types["sdf-fonts"]               = "bool";
 
     arg_types["disable-auto-rotate"] = "bool";
     arg_types["disable-auto-skip"]   = "bool";
     arg_types["disable-input"]       = "bool";
+    arg_types["disable-label-culling"] = "bool";
 
     arg_types["git-log-command"]= "bool";
     arg_types["cvs-exp-command"]= "bool";
@@ -309,10 +336,16 @@ GourceSettings::GourceSettings() {
     arg_types["user-friction"]     = "float";
     arg_types["padding"]           = "float";
     arg_types["time-scale"]        = "float";
+    arg_types["time-warp-min"]     = "float";
+    arg_types["time-warp-max"]     = "float";
     arg_types["dir-name-position"] = "float";
     arg_types["loop-delay-seconds"] = "float";
 
     arg_types["max-files"] = "int";
+    arg_types["bot-max-files"] = "int";
+    arg_types["dir-lod-files"] = "int";
+    arg_types["bulk-commit-files"] = "int";
+    arg_types["reorder-window"] = "int";
     arg_types["font-size"] = "int";
     arg_types["font-scale"] = "float";
     arg_types["file-font-size"] = "int";
@@ -322,9 +355,11 @@ GourceSettings::GourceSettings() {
 
     arg_types["user-filter"]      = "multi-value";
     arg_types["user-show-filter"] = "multi-value";
+    arg_types["bot-filter"]       = "multi-value";
     arg_types["file-filter"]      = "multi-value";
     arg_types["file-show-filter"] = "multi-value";
     arg_types["follow-user"]      = "multi-value";
+    arg_types["merge-repo"]       = "multi-value";
     arg_types["highlight-user"]   = "multi-value";
 
     arg_types["log-level"]          = "string";
@@ -348,6 +383,7 @@ GourceSettings::GourceSettings() {
     arg_types["start-position"]     = "string";
     arg_types["start-date"]         = "string";
     arg_types["stop-date"]          = "string";
+    arg_types["output-segment"]     = "string";
     arg_types["stop-position"]      = "string";
     arg_types["crop"]               = "string";
     arg_types["hide"]               = "string";
@@ -379,6 +415,7 @@ void GourceSettings::setGourceDefaults() {
     default_path = true;
 
     ffp = false;
+    sdf_fonts = false;
 
     hide_date      = false;
     hide_users     = false;
@@ -401,6 +438,9 @@ void GourceSettings::setGourceDefaults() {
     start_position  = 0.0f;
     stop_position   = 0.0f;
     stop_at_time    = -1.0f;
+
+    output_segment_index = 1;
+    output_segment_count = 1;
     stop_on_idle    = false;
     stop_at_end     = false;
     dont_stop       = false;
@@ -411,6 +451,7 @@ void GourceSettings::setGourceDefaults() {
     show_key = false;
 
     disable_auto_rotate = false;
+    disable_label_culling = false;
 
     disable_input = false;
 
@@ -420,6 +461,10 @@ void GourceSettings::setGourceDefaults() {
     file_idle_time_at_end = 0.0f;
     time_scale            = 1.0f;
 
+    time_warp     = false;
+    time_warp_min = 0.25f;
+    time_warp_max = 16.0f;
+
     loop = false;
     loop_delay_seconds = 3.0f;
 
@@ -473,6 +518,9 @@ void GourceSettings::setGourceDefaults() {
     date_format = "%A, %d %B, %Y %X";
 
     max_files      = 0;
+    dir_lod_files  = 1000;
+    bulk_commit_files = 1000;
+    reorder_window = 0;
     max_user_speed = 500.0f;
     max_file_lag   = 5.0f;
 
@@ -481,6 +529,7 @@ void GourceSettings::setGourceDefaults() {
     user_scale     = 1.0f;
 
     follow_users.clear();
+    merge_repos.clear();
     highlight_users.clear();
     highlight_all_users = false;
     highlight_dirs = false;
@@ -496,33 +545,20 @@ void GourceSettings::setGourceDefaults() {
 
     gStringHashSeed = 31;
 
-    //delete file filters
-    for(std::vector<Regex*>::iterator it = file_filters.begin(); it != file_filters.end(); it++) {
-        delete (*it);
-    }
+    //clear file filters and whitelists
     file_filters.clear();
-
-    //delete file whitelists
-    for(std::vector<Regex*>::iterator it = file_show_filters.begin(); it != file_show_filters.end(); it++) {
-        delete (*it);
-    }    
     file_show_filters.clear();
 
     file_extensions = false;
     file_extension_fallback = false;
 
-    //delete user filters
-    for(std::vector<Regex*>::iterator it = user_filters.begin(); it != user_filters.end(); it++) {
-        delete (*it);
-    }
+    //clear user filters and whitelists
     user_filters.clear();
-
-    //delete user whitelist
-    for(std::vector<Regex*>::iterator it = user_show_filters.begin(); it != user_show_filters.end(); it++) {
-        delete (*it);
-    }
     user_show_filters.clear();
 
+    bot_filters.clear();
+    bot_max_files = 10;
+
 
     setScaledFontSizes();
 }
@@ -613,9 +649,47 @@ void GourceSettings::commandLineOption(const std::string& name, const std::strin
 }
 
 
-#ifdef __APPLE__
-#include <CoreFoundation/CoreFoundation.h>
+// find the image in user-image-dir named after the user, with a .jpg, .jpeg
+// or .png extension in either case. results are remembered, as users can
+// appear more than once.
+
+bool GourceSettings::findUserImage(const std::string& name, std::string& image_path) {
+
+    std::map<std::string, std::string>::iterator it = user_image_map.find(name);
+
+    if(it != user_image_map.end()) {
+        image_path = it->second;
+        return !image_path.empty();
+    }
+
+    static const char* image_extensions[] = { ".png", ".jpg", ".jpeg", ".PNG", ".JPG", ".JPEG" };
+
+    image_path.clear();
+
+    // not a file name
+    if(name.empty() || name.find_first_of("/\\") != std::string::npos) return false;
+
+    for(const char* ext : image_extensions) {
+        std::string candidate = user_image_dir + name + ext;
+
+        std::error_code error;
+#ifdef _WIN32
+        bool found = fs::is_regular_file(fs::u8path(candidate), error);
+#else
+        bool found = fs::is_regular_file(fs::path(candidate), error);
 #endif
+        if(found) {
+            image_path = candidate;
+            debugLog("%s => %s", name.c_str(), image_path.c_str());
+            break;
+        }
+    }
+
+    user_image_map[name] = image_path;
+
+    return !image_path.empty();
+}
+
 void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gource_settings) {
 
     setGourceDefaults();
@@ -721,6 +795,10 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
         disable_auto_rotate=true;
     }
 
+    if(gource_settings->getBool("disable-label-culling")) {
+        disable_label_culling=true;
+    }
+
     if(gource_settings->getBool("disable-auto-skip")) {
         auto_skip_seconds = -1.0;
     }
@@ -821,57 +899,11 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
 
         user_image_map.clear();
 
-        fs::path image_dir_path(user_image_dir);
-
-        if(!fs::is_directory(image_dir_path)) {
+        // images are looked up as users appear rather than by listing
+        // the directory, which can hold a very large number of images
+        if(!fs::is_directory(fs::path(user_image_dir))) {
              conffile.entryException(entry, "specified user-image-dir is not a directory");
         }
-
-        std::vector<fs::path> image_dir_files;
-
-        try {
-            for(const auto& dir_entry : fs::directory_iterator(image_dir_path)) {
-                image_dir_files.push_back(dir_entry.path());
-            }
-        } catch(const fs::filesystem_error& exception) {
-             conffile.entryException(entry, "error reading specified user-image-dir");
-        }
-
-        for(fs::path& p : image_dir_files) {
-
-            std::string dirfile;
-
-#ifdef _WIN32
-            std::wstring dirfile_16 = p.filename().wstring();
-            utf8::utf16to8(dirfile_16.begin(), dirfile_16.end(), back_inserter(dirfile));
-#else
-            dirfile = p.filename().string();
-#endif
-            std::string file_ext = p.extension().string();
-            std::transform(file_ext.begin(), file_ext.end(), file_ext.begin(),
-                           [](unsigned char c){ return std::tolower(c); });
-
-            if(file_ext != ".jpg" && file_ext != ".jpeg" && file_ext != ".png") continue;
-
-            std::string image_path = gGourceSettings.user_image_dir + dirfile;
-            std::string name       = dirfile.substr(0,dirfile.size() - file_ext.size());
-
-#ifdef __APPLE__
-                CFMutableStringRef help = CFStringCreateMutable(kCFAllocatorDefault, 0);
-                CFStringAppendCString(help, name.c_str(), kCFStringEncodingUTF8);
-                CFStringNormalize(help, kCFStringNormalizationFormC);
-                char data[4096];
-                CFStringGetCString(help,
-                                   data,
-                                   sizeof(data),
-                                   kCFStringEncodingUTF8);
-                name = data;
-#endif
-
-            debugLog("%s => %s", name.c_str(), image_path.c_str());
-
-            user_image_map[name] = image_path;
-        }
     }
 
     if((entry = gource_settings->getEntry("caption-file")) != 0) {
@@ -1279,6 +1311,46 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
         }
     }
 
+    if(gource_settings->getBool("time-warp")) {
+        time_warp = true;
+    }
+
+    if((entry = gource_settings->getEntry("time-warp-min")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify time-warp-min (scale)");
+
+        time_warp_min = entry->getFloat();
+
+        if(time_warp_min <= 0.0f || time_warp_min > 1.0f) {
+            conffile.entryException(entry, "time-warp-min outside of range 0.0 - 1.0");
+        }
+    }
+
+    if((entry = gource_settings->getEntry("time-warp-max")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify time-warp-max (scale)");
+
+        time_warp_max = entry->getFloat();
+
+        if(time_warp_max < 1.0f) {
+            conffile.entryException(entry, "time-warp-max must be at least 1.0");
+        }
+    }
+
+    if((entry = gource_settings->getEntry("output-segment")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify output-segment (INDEX/COUNT)");
+
+        int index = 0, count = 0;
+
+        if(sscanf(entry->getString().c_str(), "%d/%d", &index, &count) != 2 || count < 1 || index < 1 || index > count) {
+            conffile.invalidValueException(entry);
+        }
+
+        output_segment_index = index;
+        output_segment_count = count;
+    }
+
     if((entry = gource_settings->getEntry("start-date")) != 0) {
 
         if(!entry->hasValue()) conffile.entryException(entry, "specify start-date (YYYY-MM-DD hh:mm:ss)");
@@ -1368,6 +1440,10 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
         ffp = true;
     }
 
+    if(gource_settings->getBool("sdf-fonts")) {
+        sdf_fonts = true;
+    }
+
     if(gource_settings->getBool("realtime")) {
         days_per_second = 1.0 / 86400.0;
     }
@@ -1408,6 +1484,39 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
         }
     }
 
+    if((entry = gource_settings->getEntry("dir-lod-files")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify dir-lod-files (number)");
+
+        dir_lod_files = entry->getInt();
+
+        if( dir_lod_files<0 || (dir_lod_files == 0 && entry->getString() != "0") ) {
+            conffile.invalidValueException(entry);
+        }
+    }
+
+    if((entry = gource_settings->getEntry("bulk-commit-files")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify bulk-commit-files (number)");
+
+        bulk_commit_files = entry->getInt();
+
+        if( bulk_commit_files<0 || (bulk_commit_files == 0 && entry->getString() != "0") ) {
+            conffile.invalidValueException(entry);
+        }
+    }
+
+    if((entry = gource_settings->getEntry("reorder-window")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify reorder-window (number)");
+
+        reorder_window = entry->getInt();
+
+        if( reorder_window<0 || (reorder_window == 0 && entry->getString() != "0") ) {
+            conffile.invalidValueException(entry);
+        }
+    }
+
     if((entry = gource_settings->getEntry("max-file-lag")) != 0) {
 
         if(!entry->hasValue()) conffile.entryException(entry, "specify max-file-lag (seconds)");
@@ -1515,6 +1624,26 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
         }
     }
 
+    if((entry = gource_settings->getEntry("merge-repo")) != 0) {
+
+        ConfEntryList* merge_repo_entries = gource_settings->getEntries("merge-repo");
+
+        for(ConfEntryList::iterator it = merge_repo_entries->begin(); it != merge_repo_entries->end(); it++) {
+
+            entry = *it;
+
+            if(!entry->hasValue()) conffile.entryException(entry, "specify merge-repo (path)");
+
+            std::string merge_repo = entry->getString();
+
+            if(merge_repo == "-") conffile.entryException(entry, "cannot merge a log read from STDIN");
+
+            if(!fs::exists(merge_repo)) conffile.entryException(entry, "merge-repo path not found");
+
+            merge_repos.push_back(merge_repo);
+        }
+    }
+
     if(gource_settings->getBool("file-extensions")) {
         file_extensions=true;
     }
@@ -1533,16 +1662,9 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
 
             if(!entry->hasValue()) conffile.entryException(entry, "specify file-filter (regex)");
 
-            std::string filter_string = entry->getString();
-
-            Regex* r = new Regex(filter_string, 1);
-
-            if(!r->isValid()) {
-                delete r;
+            if(!file_filters.add(entry->getString())) {
                 conffile.entryException(entry, "invalid file-filter regular expression");
             }
-
-            file_filters.push_back(r);
         }
     }
 
@@ -1556,16 +1678,9 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
 
             if(!entry->hasValue()) conffile.entryException(entry, "specify file-show-filter (regex)");
 
-            std::string filter_string = entry->getString();
-
-            Regex* r = new Regex(filter_string, 1);
-
-            if(!r->isValid()) {
-                delete r;
+            if(!file_show_filters.add(entry->getString())) {
                 conffile.entryException(entry, "invalid file-show-filter regular expression");
             }
-
-            file_show_filters.push_back(r);
         }
     }
 
@@ -1579,16 +1694,9 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
 
             if(!entry->hasValue()) conffile.entryException(entry, "specify user-filter (regex)");
 
-            std::string filter_string = entry->getString();
-
-            Regex* r = new Regex(filter_string, 1);
-
-            if(!r->isValid()) {
-                delete r;
+            if(!user_filters.add(entry->getString())) {
                 conffile.entryException(entry, "invalid user-filter regular expression");
             }
-
-            user_filters.push_back(r);
         }
     }
 
@@ -1602,16 +1710,36 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
 
             if(!entry->hasValue()) conffile.entryException(entry, "specify user-show-filter (regex)");
 
-            std::string filter_string = entry->getString();
+            if(!user_show_filters.add(entry->getString())) {
+                conffile.entryException(entry, "invalid user-show-filter regular expression");
+            }
+        }
+    }
 
-            Regex* r = new Regex(filter_string, 1);
+    if((entry = gource_settings->getEntry("bot-filter")) != 0) {
 
-            if(!r->isValid()) {
-                delete r;
-                conffile.entryException(entry, "invalid user-show-filter regular expression");
+        ConfEntryList* filters = gource_settings->getEntries("bot-filter");
+
+        for(ConfEntryList::iterator it = filters->begin(); it != filters->end(); it++) {
+
+            entry = *it;
+
+            if(!entry->hasValue()) conffile.entryException(entry, "specify bot-filter (regex)");
+
+            if(!bot_filters.add(entry->getString())) {
+                conffile.entryException(entry, "invalid bot-filter regular expression");
             }
+        }
+    }
+
+    if((entry = gource_settings->getEntry("bot-max-files")) != 0) {
+
+        if(!entry->hasValue()) conffile.entryException(entry, "specify bot-max-files (number)");
 
-            user_show_filters.push_back(r);
+        bot_max_files = entry->getInt();
+
+        if(bot_max_files < 1) {
+            conffile.invalidValueException(entry);
         }
     }
 
@@ -1649,6 +1777,10 @@ void GourceSettings::importGourceSettings(ConfFile& conffile, ConfSection* gourc
             throw ConfFileException("log-format required when reading from STDIN", "", 0);
         }
 
+        if(!merge_repos.empty()) {
+            throw ConfFileException("cannot merge a log read from STDIN", "", 0);
+        }
+
 #ifdef _WIN32
         DWORD available_bytes;
         HANDLE stdin_handle = GetStdHandle(STD_INPUT_HANDLE);
@@ -43,6 +43,7 @@ public:
     bool hide_root;
 
     bool disable_auto_rotate;
+    bool disable_label_culling;
 
     bool disable_input;
 
@@ -65,6 +66,9 @@ public:
     float stop_position;
     float stop_at_time;
 
+    int output_segment_index;
+    int output_segment_count;
+
     bool shutdown;
     bool stop_on_idle;
     bool stop_at_end;
@@ -79,15 +83,22 @@ public:
     float file_idle_time_at_end;
     float loop_delay_seconds;
 
+    bool time_warp;
+    float time_warp_min;
+    float time_warp_max;
+
     bool loop;
 
     bool ffp;
+    bool sdf_fonts;
 
     bool colour_user_images;
     std::string default_user_image;
     std::string user_image_dir;
     std::map<std::string, std::string> user_image_map;
 
+    bool findUserImage(const std::string& name, std::string& image_path);
+
     float camera_zoom_min;
     float camera_zoom_max;
     float camera_zoom_default;
@@ -128,6 +139,9 @@ public:
     std::string date_format;
 
     int max_files;
+    int dir_lod_files;
+    int bulk_commit_files;
+    int reorder_window;
     float max_user_speed;
     float max_file_lag;
 
@@ -148,10 +162,13 @@ public:
 
     std::vector<std::string> highlight_users;
     std::vector<std::string> follow_users;
-    std::vector<Regex*> file_filters;
-    std::vector<Regex*> file_show_filters;
-    std::vector<Regex*> user_filters;
-    std::vector<Regex*> user_show_filters;
+    std::vector<std::string> merge_repos;
+    RegexFilter file_filters;
+    RegexFilter file_show_filters;
+    RegexFilter user_filters;
+    RegexFilter user_show_filters;
+    RegexFilter bot_filters;
+    int bot_max_files;
     bool file_extensions;
     bool file_extension_fallback;
 
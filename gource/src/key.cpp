@@ -223,13 +223,13 @@ void FileKey::inc(RFile* file) {
 
     FileKeyEntry* entry = 0;
 
-    std::map<std::string, FileKeyEntry*>::iterator result = keymap.find(file->ext);
+    std::map<std::string, FileKeyEntry*>::iterator result = keymap.find(file->getExt());
 
     if(result != keymap.end()) {
         entry = result->second;
     } else {
-        entry = new FileKeyEntry(font, file->ext, file->getFileColour());
-        keymap[file->ext] = entry;
+        entry = new FileKeyEntry(font, file->getExt(), file->getFileColour());
+        keymap[file->getExt()] = entry;
     }
 
     entry->inc();
@@ -239,7 +239,7 @@ void FileKey::inc(RFile* file) {
 //decrement count of extension. if drops to zero, mark it for removal
 void FileKey::dec(RFile* file) {
 
-    std::map<std::string, FileKeyEntry*>::iterator result = keymap.find(file->ext);
+    std::map<std::string, FileKeyEntry*>::iterator result = keymap.find(file->getExt());
 
     if(result == keymap.end()) return;
 
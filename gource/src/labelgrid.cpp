@@ -0,0 +1,113 @@
+// === File: src/labelgrid.cpp =================================================
+// AGENT: PURPOSE    — Screen space placement of directory and file name labels
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#include "labelgrid.h"
+#include "dirnode.h"
+#include "file.h"
+
+#include <algorithm>
+#include <cmath>
+
+// labels that changed within the same quarter second are ordered by size
+
+static int label_recency(const RLabel& label) {
+    return (int) (label.age * 4.0f);
+}
+
+static bool label_priority(const RLabel& a, const RLabel& b) {
+    int recency_a = label_recency(a);
+    int recency_b = label_recency(b);
+
+    if(recency_a != recency_b) return recency_a < recency_b;
+
+    return a.dims.y > b.dims.y;
+}
+
+RLabelGrid::RLabelGrid(int cell_size) : cell_size(cell_size) {
+    columns = rows = 0;
+    drawn_count = 0;
+}
+
+void RLabelGrid::reset(int width, int height) {
+    columns = (width  + cell_size - 1) / cell_size;
+    rows    = (height + cell_size - 1) / cell_size;
+
+    cells.assign(columns * rows, 0);
+    labels.clear();
+
+    drawn_count = 0;
+}
+
+void RLabelGrid::addDirName(RDirNode* dir, const vec2& pos, const vec2& dims, float age) {
+    RLabel label;
+    label.dir  = dir;
+    label.file = 0;
+    label.pos  = pos;
+    label.dims = dims;
+    label.age  = age;
+
+    labels.push_back(label);
+}
+
+void RLabelGrid::addFileName(RFile* file, const vec2& pos, const vec2& dims, float age) {
+    RLabel label;
+    label.dir  = 0;
+    label.file = file;
+    label.pos  = pos;
+    label.dims = dims;
+    label.age  = age;
+
+    labels.push_back(label);
+}
+
+bool RLabelGrid::reserve(const vec2& pos, const vec2& dims) {
+
+    int x1 = (int) floorf(pos.x / cell_size);
+    int y1 = (int) floorf(pos.y / cell_size);
+    int x2 = (int) floorf((pos.x + dims.x) / cell_size);
+    int y2 = (int) floorf((pos.y + dims.y) / cell_size);
+
+    // entirely off screen
+    if(x2 < 0 || y2 < 0 || x1 >= columns || y1 >= rows) return false;
+
+    x1 = std::max(0, x1);
+    y1 = std::max(0, y1);
+    x2 = std::min(columns - 1, x2);
+    y2 = std::min(rows - 1, y2);
+
+    for(int y = y1; y <= y2; y++) {
+        const unsigned char* row = &(cells[y * columns]);
+        for(int x = x1; x <= x2; x++) {
+            if(row[x]) return false;
+        }
+    }
+
+    for(int y = y1; y <= y2; y++) {
+        unsigned char* row = &(cells[y * columns]);
+        std::fill(row + x1, row + x2 + 1, 1);
+    }
+
+    return true;
+}
+
+void RLabelGrid::draw(FXFont& dirfont) {
+
+    // stable so labels that tie keep the order of the tree
+    std::stable_sort(labels.begin(), labels.end(), label_priority);
+
+    for(std::vector<RLabel>::iterator it = labels.begin(); it != labels.end(); it++) {
+        RLabel& label = *it;
+
+        if(!reserve(label.pos, label.dims)) continue;
+
+        if(label.dir != 0) {
+            label.dir->drawDirName(dirfont);
+        } else {
+            label.file->drawName();
+        }
+
+        drawn_count++;
+    }
+}
@@ -0,0 +1,54 @@
+// === File: src/labelgrid.h ===================================================
+// AGENT: PURPOSE    — Screen space placement of directory and file name labels
+// AGENT: STATUS     — in-progress (2026-10-18)
+// =============================================================================
+
+#ifndef RLABELGRID_H
+#define RLABELGRID_H
+
+#include "core/fxfont.h"
+#include "core/vectors.h"
+
+#include <vector>
+
+class RDirNode;
+class RFile;
+
+struct RLabel {
+    RDirNode* dir;
+    RFile* file;
+    vec2 pos;
+    vec2 dims;
+    float age;
+};
+
+// labels are queued with their screen space bounds and the time since their
+// node last changed, then placed most recent (and at equal recency, largest)
+// first. a label is only drawn if none of the grid cells it covers are
+// already occupied by a label placed before it.
+
+class RLabelGrid {
+    int cell_size;
+    int columns, rows;
+    std::vector<unsigned char> cells;
+
+    std::vector<RLabel> labels;
+
+    size_t drawn_count;
+
+    bool reserve(const vec2& pos, const vec2& dims);
+public:
+    RLabelGrid(int cell_size = 4);
+
+    void reset(int width, int height);
+
+    void addDirName(RDirNode* dir, const vec2& pos, const vec2& dims, float age);
+    void addFileName(RFile* file, const vec2& pos, const vec2& dims, float age);
+
+    void draw(FXFont& dirfont);
+
+    size_t getLabelCount() const { return labels.size(); };
+    size_t getDrawnCount() const { return drawn_count; };
+};
+
+#endif
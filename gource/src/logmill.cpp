@@ -32,6 +32,7 @@
 #include "formats/apache.h"
 #include "formats/cvs-exp.h"
 #include "formats/cvs2cl.h"
+#include "formats/merged.h"
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -93,12 +94,28 @@ void RLogMill::run() {
 
     try {
 
-        clog = fetchLog(log_format);
+        if(gGourceSettings.merge_repos.empty()) {
+            clog = fetchLog(log_format);
+        } else {
+            clog = fetchMergedLog();
+        }
         printf("RLogMill::run() - fetchLog returned %p\n", (void*)clog);
 
+        // time warp, output segments and the start date need the activity of the
+        // whole log before playback starts. otherwise the index is filled in as
+        // the log is read.
+        if(clog != 0 && clog->isSeekable() && (gGourceSettings.time_warp || gGourceSettings.output_segment_count > 1 || gGourceSettings.start_timestamp != 0)) {
+            activity.build(clog);
+        }
+
         // find first commit after start_timestamp if specified
         if(clog != 0 && gGourceSettings.start_timestamp != 0) {
 
+            // skip to just before the first commit at the start time
+            if(activity.isComplete()) {
+                clog->seekTo(activity.getPercentAt(gGourceSettings.start_timestamp));
+            }
+
             RCommit commit;
 
             while(!gGourceSettings.shutdown && !clog->isFinished()) {
@@ -175,6 +192,14 @@ RCommitLog* RLogMill::getLog() {
     return clog;
 }
 
+RActivityIndex& RLogMill::getActivityIndex() {
+    return activity;
+}
+
+const RActivityIndex& RLogMill::getActivityIndex() const {
+    return activity;
+}
+
 bool RLogMill::findRepository(fs::path& dir, std::string& log_format) {
 
     dir = fs::canonical(dir);
@@ -202,6 +227,53 @@ bool RLogMill::findRepository(fs::path& dir, std::string& log_format) {
 }
 
 
+// open the log of the path and of each merge-repo and merge them by time
+
+RCommitLog* RLogMill::fetchMergedLog() {
+
+    // stream the logs from disk, rather than each being held in memory
+    gSeekLogMaxBufferSize = 0;
+
+    std::vector<std::string> paths;
+    paths.push_back(logfile);
+    paths.insert(paths.end(), gGourceSettings.merge_repos.begin(), gGourceSettings.merge_repos.end());
+
+    RMergedCommitLog* merged = new RMergedCommitLog();
+
+    for(const std::string& path : paths) {
+
+        logfile = path;
+
+        std::string log_format = gGourceSettings.log_format;
+
+        RCommitLog* clog = 0;
+
+        try {
+            clog = fetchLog(log_format);
+        } catch(...) {
+            delete merged;
+            logfile = paths[0];
+            throw;
+        }
+
+        // logs have to be seekable to tell when they have finished
+        if(clog == 0 || !clog->isSeekable()) {
+            if(clog != 0) delete clog;
+            delete merged;
+
+            logfile = paths[0];
+            error   = std::string("unable to read log of ") + path;
+            return 0;
+        }
+
+        merged->addLog(clog, merged->getLogPrefix(path));
+    }
+
+    logfile = paths[0];
+
+    return merged;
+}
+
 RCommitLog* RLogMill::fetchLog(std::string& log_format) {
 
     RCommitLog* clog = 0;
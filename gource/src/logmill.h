@@ -31,6 +31,7 @@
 #include "core/display.h"
 
 #include "formats/commitlog.h"
+#include "activity.h"
 
 #if defined(HAVE_PTHREAD) && !defined(_WIN32)
 #include <signal.h>
@@ -53,10 +54,13 @@ class RLogMill {
     std::string logfile;
     RCommitLog* clog;
 
+    RActivityIndex activity;
+
     std::string error;
 
     bool findRepository(std::filesystem::path& dir, std::string& log_format);
     RCommitLog* fetchLog(std::string& log_format);
+    RCommitLog* fetchMergedLog();
 public:
     RLogMill(const std::string& logfile);
     ~RLogMill();
@@ -71,6 +75,9 @@ public:
     bool isFinished();
 
     RCommitLog* getLog();
+
+    RActivityIndex& getActivityIndex();
+    const RActivityIndex& getActivityIndex() const;
 };
 
 #endif
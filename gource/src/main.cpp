@@ -146,9 +146,49 @@ int main(int argc, char* argv[]) {
 
         Logger::getDefault()->setLevel(gGourceSettings.log_level);
 
+#ifndef __EMSCRIPTEN__
+        // native builds take their settings from the command line
+        std::vector<std::string> files;
+
+        gGourceSettings.parseArgs(argc, argv, *g_conf, &files);
+
+        Logger::getDefault()->setLevel(gGourceSettings.log_level);
+
+        if (!gGourceSettings.load_config.empty()) {
+            g_conf->clear();
+            g_conf->load(gGourceSettings.load_config);
+
+            // arguments override the loaded config
+            gGourceSettings.parseArgs(argc, argv, *g_conf);
+        }
+
+        // the last file argument is the log to visualise
+        if (!files.empty()) {
+            const std::string& path = files.back();
+
+            ConfSectionList* sectionlist = g_conf->getSections("gource");
+
+            if (sectionlist != nullptr) {
+                for (ConfSection* section : *sectionlist) {
+                    section->setEntry("path", path);
+                }
+            } else {
+                g_conf->setEntry("gource", "path", path);
+            }
+        }
+
+        gGourceSettings.importDisplaySettings(*g_conf);
+        gGourceSettings.importGourceSettings(*g_conf);
+
+        if (!gGourceSettings.save_config.empty()) {
+            g_conf->save(gGourceSettings.save_config);
+            return 0;
+        }
+#else
         // Import settings - skip for web since we have no config file
         // gGourceSettings.importDisplaySettings(*g_conf);
         // gGourceSettings.importGourceSettings(*g_conf);
+#endif
 
     } catch (ConfFileException& exception) {
         printf("ConfFileException: %s\n", exception.what());
@@ -197,8 +237,46 @@ int main(int argc, char* argv[]) {
     // Native build - require a log file argument
     GourceShell* gourcesh = nullptr;
 
+    // frame exporter, writing Y4M if requested or implied by the file extension
+    FrameExporter* exporter = nullptr;
+
+    if (!gGourceSettings.output_ppm_filename.empty()) {
+        const std::string& filename = gGourceSettings.output_ppm_filename;
+
+        std::string format = gGourceSettings.output_format;
+
+        if (format.empty()) {
+            format = (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".y4m") == 0) ? "y4m" : "ppm";
+        }
+
+        try {
+            if (format == "y4m" && (gGourceSettings.output_scale > 1 || gGourceSettings.output_supersample > 1)) {
+                SDLAppQuit("--output-scale and --output-supersample require ppm or png output");
+            }
+
+            if (format == "y4m") {
+                exporter = new Y4MExporter(filename, gGourceSettings.output_framerate);
+            } else if (format == "png") {
+                int threads = gGourceSettings.output_threads > 0 ? gGourceSettings.output_threads : SDL_GetCPUCount();
+
+                exporter = new PNGSequenceExporter(filename, threads,
+                    gGourceSettings.output_png_compression, gGourceSettings.output_png_filters);
+            } else {
+                exporter = new PPMExporter(filename);
+            }
+        } catch (PPMExporterException& exception) {
+            char errormsg[1024];
+            snprintf(errormsg, 1024, "could not write to '%s'", exception.what());
+            SDLAppQuit(errormsg);
+        } catch (PNGExporterException& exception) {
+            char errormsg[1024];
+            snprintf(errormsg, 1024, "could not write to '%s'", exception.what());
+            SDLAppQuit(errormsg);
+        }
+    }
+
     try {
-        gourcesh = gGourceShell = new GourceShell(g_conf, nullptr);
+        gourcesh = gGourceShell = new GourceShell(g_conf, exporter);
         gourcesh->run();
     } catch (ResourceException& exception) {
         char errormsg[1024];
@@ -216,6 +294,8 @@ int main(int argc, char* argv[]) {
 
     if (gourcesh != nullptr) delete gourcesh;
 
+    if (exporter != nullptr) delete exporter;
+
     display.quit();
 
     return 0;
@@ -20,5 +20,6 @@
 
 #include "gource_shell.h"
 #include "gource.h"
+#include "core/png_writer.h"
 
 #endif
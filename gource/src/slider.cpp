@@ -27,6 +27,7 @@
 
 PositionSlider::PositionSlider(float percent) {
     this->percent = percent;
+    this->activity = 0;
 }
 
 void PositionSlider::init() {
@@ -106,6 +107,10 @@ void PositionSlider::setCaption(const std::string& caption) {
     }
 }
 
+void PositionSlider::setActivity(const RActivityIndex* activity) {
+    this->activity = activity;
+}
+
 void PositionSlider::setPercent(float percent) {
     this->percent = percent;
 }
@@ -139,6 +144,43 @@ void PositionSlider::drawSlider(float pos_x) const {
     r.end();
 }
 
+//sparkline of commit activity along the log, filled in as the log is read
+void PositionSlider::drawActivity() const {
+    if(activity == 0) return;
+
+    auto& r = renderer();
+
+    float slider_width  = bounds.max.x - bounds.min.x;
+    float slider_height = bounds.max.y - bounds.min.y - 4.0f;
+
+    int columns = (int) slider_width;
+
+    if(columns <= 0 || slider_height <= 0.0f) return;
+
+    glLineWidth(1.0f);
+
+    r.color(slidercol.x, slidercol.y, slidercol.z, 0.5f * alpha);
+
+    r.begin(GL_LINES);
+
+    for(int i=0; i < columns; i++) {
+
+        float column_activity = activity->getActivity(i / slider_width, (i+1) / slider_width);
+
+        if(column_activity <= 0.0f) continue;
+
+        // square root so quiet periods remain visible next to busy ones
+        float column_height = glm::max(1.0f, sqrtf(column_activity) * slider_height);
+
+        float x = bounds.min.x + i + 0.5f;
+
+        r.vertex(x, bounds.max.y - 2.0f);
+        r.vertex(x, bounds.max.y - 2.0f - column_height);
+    }
+
+    r.end();
+}
+
 void PositionSlider::draw(float dt) {
     auto& r = renderer();
 
@@ -147,6 +189,8 @@ void PositionSlider::draw(float dt) {
 
     float pos_x = bounds.min.x + (bounds.max.x - bounds.min.x) * percent;
 
+    drawActivity();
+
     r.color(0.0f, 0.0f, 0.0f, 0.7f*alpha);
 
     r.pushModelView();
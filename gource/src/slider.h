@@ -22,6 +22,8 @@
 #include "core/bounds.h"
 #include "core/fxfont.h"
 
+#include "activity.h"
+
 class PositionSlider {
 
     FXFont font;
@@ -38,7 +40,10 @@ class PositionSlider {
     float capwidth;
     std::string caption;
 
+    const RActivityIndex* activity;
+
     void drawSlider(float position) const;
+    void drawActivity() const;
 public:
     PositionSlider(float percent = 0.0f);
 
@@ -48,6 +53,8 @@ public:
 
     void setCaption(const std::string& cap);
 
+    void setActivity(const RActivityIndex* activity);
+
     void setPercent(float percent);
 
     void resize();
@@ -0,0 +1,241 @@
+/*
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation; either version
+    3 of the License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "../actionqueue.h"
+#include "../action.h"
+#include "../dirnode.h"
+#include "../file.h"
+
+#include <boost/test/unit_test.hpp>
+
+static RFile* add_file(RDirNode* dir, const std::string& filename) {
+    RFile* file = new RFile(filename, 0);
+
+    dir->addFile(file);
+    file->touch(0, vec3(1.0f));
+
+    return file;
+}
+
+// move the files of a directory to their places
+static void settle_files(RDirNode* dir) {
+    dir->getFileStore().logic(1.0f);
+}
+
+// the first of the actions, in the order they were queued, with a file in range
+static RAction* first_in_range(std::vector<RAction*>& actions, const vec2& pos, float distance) {
+
+    for(std::vector<RAction*>::iterator it = actions.begin(); it != actions.end(); it++) {
+        if(glm::length((*it)->target->getAbsolutePos() - pos) < distance) {
+            RAction* action = *it;
+            actions.erase(it);
+            return action;
+        }
+    }
+
+    return 0;
+}
+
+BOOST_AUTO_TEST_CASE( action_queue_time_tests )
+{
+    RDirNode* dir = new RDirNode(0, "/a/");
+    RFile* file = add_file(dir, "/a/a.txt");
+
+    RAction* a1 = new RAction(0, file, 0, 3.0f, vec3(1.0f));
+    RAction* a2 = new RAction(0, file, 0, 1.0f, vec3(1.0f));
+    RAction* a3 = new RAction(0, file, 0, 2.0f, vec3(1.0f));
+
+    RActionQueue queue;
+    queue.push(a1);
+    queue.push(a2);
+    queue.push(a3);
+
+    BOOST_CHECK_EQUAL(queue.size(), 3);
+    BOOST_CHECK(queue.front() == a1);
+
+    // oldest first, regardless of the order they were queued
+    BOOST_CHECK(queue.popOlderThan(1.0f) == 0);
+    BOOST_CHECK(queue.popOlderThan(2.5f) == a2);
+    BOOST_CHECK(queue.popOlderThan(2.5f) == a3);
+    BOOST_CHECK(queue.popOlderThan(2.5f) == 0);
+
+    BOOST_CHECK(queue.front() == a1);
+    BOOST_CHECK(queue.popOlderThan(10.0f) == a1);
+    BOOST_CHECK(queue.empty());
+
+    delete a1;
+    delete a2;
+    delete a3;
+    delete file;
+    delete dir;
+}
+
+BOOST_AUTO_TEST_CASE( action_queue_range_tests )
+{
+    RDirNode* dir_a = new RDirNode(0, "/a/");
+    RDirNode* dir_b = new RDirNode(0, "/b/");
+
+    dir_a->setPos(vec2(0.0f, 0.0f));
+    dir_b->setPos(vec2(100.0f, 0.0f));
+
+    RFile* file_a = add_file(dir_a, "/a/a.txt");
+    RFile* file_b = add_file(dir_b, "/b/b.txt");
+
+    settle_files(dir_a);
+    settle_files(dir_b);
+
+    RAction* a1 = new RAction(0, file_a, 0, 0.0f, vec3(1.0f));
+    RAction* b1 = new RAction(0, file_b, 0, 0.0f, vec3(1.0f));
+    RAction* a2 = new RAction(0, file_a, 0, 0.0f, vec3(1.0f));
+    RAction* b2 = new RAction(0, file_b, 0, 0.0f, vec3(1.0f));
+
+    RActionQueue queue;
+    queue.push(a1);
+    queue.push(b1);
+    queue.push(a2);
+    queue.push(b2);
+
+    BOOST_CHECK(queue.popInRange(vec2(50.0f, 0.0f), 10.0f) == 0);
+
+    // only the second directory is in range
+    BOOST_CHECK(queue.popInRange(vec2(95.0f, 0.0f), 10.0f) == b1);
+
+    // the earliest queued action of either directory
+    BOOST_CHECK(queue.popInRange(vec2(50.0f, 0.0f), 60.0f) == a1);
+    BOOST_CHECK(queue.popInRange(vec2(50.0f, 0.0f), 60.0f) == a2);
+    BOOST_CHECK(queue.popInRange(vec2(50.0f, 0.0f), 60.0f) == b2);
+    BOOST_CHECK(queue.popInRange(vec2(50.0f, 0.0f), 60.0f) == 0);
+
+    BOOST_CHECK(queue.empty());
+
+    delete a1;
+    delete b1;
+    delete a2;
+    delete b2;
+    delete file_a;
+    delete file_b;
+    delete dir_a;
+    delete dir_b;
+}
+
+BOOST_AUTO_TEST_CASE( action_queue_remove_tests )
+{
+    RDirNode* dir = new RDirNode(0, "/a/");
+
+    RFile* file1 = add_file(dir, "/a/1.txt");
+    RFile* file2 = add_file(dir, "/a/2.txt");
+
+    RAction* a1 = new RAction(0, file1, 0, 0.0f, vec3(1.0f));
+    RAction* b  = new RAction(0, file2, 0, 1.0f, vec3(1.0f));
+    RAction* a2 = new RAction(0, file1, 0, 2.0f, vec3(1.0f));
+
+    RActionQueue queue;
+    queue.push(a1);
+    queue.push(b);
+    queue.push(a2);
+
+    std::vector<RAction*> removed;
+    queue.removeTarget(file1, removed);
+
+    BOOST_CHECK_EQUAL(removed.size(), 2);
+    BOOST_CHECK(removed[0] == a1);
+    BOOST_CHECK(removed[1] == a2);
+
+    BOOST_CHECK_EQUAL(queue.size(), 1);
+    BOOST_CHECK(queue.front() == b);
+
+    // removed from the time index too
+    BOOST_CHECK(queue.popOlderThan(10.0f) == b);
+    BOOST_CHECK(queue.empty());
+
+    removed.clear();
+    queue.removeTarget(file1, removed);
+    BOOST_CHECK(removed.empty());
+
+    delete a1;
+    delete b;
+    delete a2;
+    delete file1;
+    delete file2;
+    delete dir;
+}
+
+// a large directory is searched by sector, which must find the same actions
+// as checking every queued action, including after the layout changes
+
+BOOST_AUTO_TEST_CASE( action_queue_sector_tests )
+{
+    RDirNode* dir = new RDirNode(0, "/a/");
+
+    std::vector<RFile*> files;
+
+    for(int i=0;i<300;i++) {
+        files.push_back(add_file(dir, "/a/" + std::to_string(i) + ".txt"));
+    }
+
+    settle_files(dir);
+
+    RActionQueue queue;
+    std::vector<RAction*> actions;
+    std::vector<RAction*> expected;
+
+    for(int i=0;i<300;i++) {
+        RAction* action = new RAction(0, files[(i*7) % 300], 0, 0.0f, vec3(1.0f));
+
+        actions.push_back(action);
+        expected.push_back(action);
+        queue.push(action);
+    }
+
+    float radius   = dir->getFilesExtent() * 0.6f;
+    float distance = 12.0f;
+
+    for(int i=0;i<8;i++) {
+
+        // the layout changes when a file is added
+        if(i == 4) {
+            files.push_back(add_file(dir, "/a/new.txt"));
+            settle_files(dir);
+        }
+
+        float angle = i * 0.8f;
+        vec2 pos(cosf(angle) * radius, sinf(angle) * radius);
+
+        int found = 0;
+
+        while(true) {
+            RAction* action = queue.popInRange(pos, distance);
+
+            BOOST_CHECK(action == first_in_range(expected, pos, distance));
+
+            if(action == 0) break;
+
+            found++;
+        }
+
+        BOOST_CHECK(found > 0);
+    }
+
+    BOOST_CHECK_EQUAL(queue.size(), expected.size());
+
+    for(size_t i=0;i<actions.size();i++) {
+        delete actions[i];
+    }
+
+    for(size_t i=0;i<files.size();i++) {
+        delete files[i];
+    }
+
+    delete dir;
+}
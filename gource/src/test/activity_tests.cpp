@@ -0,0 +1,154 @@
+/*
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation; either version
+    3 of the License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "../activity.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE( activity_index_tests )
+{
+    RActivityIndex activity(10);
+
+    BOOST_CHECK_EQUAL(activity.size(), 10);
+    BOOST_CHECK_EQUAL(activity.getActivity(0.0f, 1.0f), 0.0f);
+
+    RCommit commit;
+    commit.files.push_back(RCommitFile("/a.txt", "A", vec3(1.0f)));
+
+    commit.timestamp = 100;
+    activity.add(0.01f, commit);
+
+    commit.timestamp = 200;
+    activity.add(0.02f, commit);
+
+    commit.timestamp = 500;
+    activity.add(0.55f, commit);
+
+    BOOST_CHECK_EQUAL(activity.getBucket(0).commits, 2);
+    BOOST_CHECK_EQUAL(activity.getBucket(0).files, 2);
+    BOOST_CHECK_EQUAL(activity.getBucket(0).min_timestamp, 100);
+    BOOST_CHECK_EQUAL(activity.getBucket(0).max_timestamp, 200);
+    BOOST_CHECK_EQUAL(activity.getBucket(5).commits, 1);
+
+    BOOST_CHECK_EQUAL(activity.getActivity(0.0f, 0.05f), 1.0f);
+    BOOST_CHECK_EQUAL(activity.getActivity(0.5f, 0.59f), 0.5f);
+    BOOST_CHECK_EQUAL(activity.getActivity(0.2f, 0.3f), 0.0f);
+
+    time_t timestamp = 0;
+    BOOST_CHECK(activity.getTimestampAt(0.3f, timestamp));
+    BOOST_CHECK_EQUAL(timestamp, 500);
+    BOOST_CHECK(activity.getTimestampAt(0.7f, timestamp) == false);
+
+    BOOST_CHECK_EQUAL(activity.getPercentAt(150), 0.0f);
+    BOOST_CHECK_CLOSE(activity.getPercentAt(300), 0.4f, 0.001f);
+    BOOST_CHECK_EQUAL(activity.getPercentAt(1000), 1.0f);
+
+    time_t first = 0, last = 0;
+    BOOST_CHECK(activity.getTimeRange(first, last));
+    BOOST_CHECK_EQUAL(first, 100);
+    BOOST_CHECK_EQUAL(last, 500);
+
+    activity.clear();
+    BOOST_CHECK_EQUAL(activity.getBucket(0).commits, 0);
+    BOOST_CHECK(activity.getTimeRange(first, last) == false);
+    BOOST_CHECK_EQUAL(activity.getTimeWarp(100, 0.25f, 16.0f), 1.0f);
+
+    // ten commits on day 0, one on day 20
+    time_t day = 86400;
+
+    for(int i=0;i<10;i++) {
+        commit.timestamp = day/2;
+        activity.add(0.0f, commit);
+    }
+
+    commit.timestamp = 20*day + day/2;
+    activity.add(1.0f, commit);
+
+    BOOST_CHECK_CLOSE(activity.getMeanDensity(), 11.0f / 21.0f, 0.001f);
+    BOOST_CHECK_CLOSE(activity.getDensity(day/2), 10.0f / 3.0f, 0.001f);
+    BOOST_CHECK_EQUAL(activity.getDensity(10*day), 0.0f);
+
+    // busy periods slow down, quiet periods speed up, within the bounds
+    BOOST_CHECK_CLOSE(activity.getTimeWarp(day/2, 0.1f, 16.0f), (11.0f / 21.0f) / (10.0f / 3.0f), 0.001f);
+    BOOST_CHECK_EQUAL(activity.getTimeWarp(day/2, 0.25f, 16.0f), 0.25f);
+    BOOST_CHECK_EQUAL(activity.getTimeWarp(10*day, 0.25f, 16.0f), 16.0f);
+    BOOST_CHECK_CLOSE(activity.getTimeWarp(20*day + day/2, 0.25f, 16.0f), (11.0f / 21.0f) * 3.0f, 0.001f);
+}
+
+BOOST_AUTO_TEST_CASE( activity_index_record_tests )
+{
+    RActivityIndex activity(10);
+
+    RCommit commit;
+    commit.files.push_back(RCommitFile("/a.txt", "A", vec3(1.0f)));
+    commit.timestamp = 100;
+
+    activity.record(0.1f, commit);
+    activity.record(0.2f, commit);
+
+    // commits read again after seeking back are not counted twice
+    activity.seekTo(0.0f, std::multiset<float>());
+    activity.record(0.1f, commit);
+    activity.record(0.2f, commit);
+
+    BOOST_CHECK_EQUAL(activity.getBucket(1).commits, 1);
+    BOOST_CHECK_EQUAL(activity.getBucket(2).commits, 1);
+
+    activity.finish();
+    BOOST_CHECK(activity.isComplete());
+
+    // skipping ahead leaves the index incomplete
+    activity.clear();
+    activity.record(0.1f, commit);
+    activity.seekTo(0.5f, std::multiset<float>());
+    activity.record(0.5f, commit);
+    activity.finish();
+
+    BOOST_CHECK_EQUAL(activity.getBucket(5).commits, 1);
+    BOOST_CHECK(activity.isComplete() == false);
+
+    // reordered commits are recorded where they were read
+    activity.clear();
+    activity.record(0.3f, commit);
+    activity.record(0.2f, commit);
+
+    BOOST_CHECK_EQUAL(activity.getBucket(2).commits, 1);
+    BOOST_CHECK_EQUAL(activity.getBucket(3).commits, 1);
+
+    // commits discarded by seeking back before they were recorded are
+    // recorded when read again, without counting the others twice
+    std::multiset<float> pending;
+    pending.insert(0.1f);
+
+    activity.clear();
+    activity.record(0.3f, commit);
+    activity.seekTo(0.0f, pending);
+    activity.record(0.1f, commit);
+    activity.record(0.3f, commit);
+    activity.finish();
+
+    BOOST_CHECK_EQUAL(activity.getBucket(1).commits, 1);
+    BOOST_CHECK_EQUAL(activity.getBucket(3).commits, 1);
+    BOOST_CHECK(activity.isComplete());
+
+    // unless the seek is past them
+    activity.clear();
+    activity.record(0.3f, commit);
+    activity.seekTo(0.2f, pending);
+    activity.record(0.3f, commit);
+    activity.finish();
+
+    BOOST_CHECK_EQUAL(activity.getBucket(3).commits, 1);
+    BOOST_CHECK(activity.isComplete() == false);
+}
@@ -0,0 +1,91 @@
+/*
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation; either version
+    3 of the License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "../formats/custom.h"
+#include "../gource_settings.h"
+
+#include <boost/test/unit_test.hpp>
+
+// the commits of reorder.log are out of order by less than three commits
+static RCommitLog* open_reordered_log(int reorder_window) {
+
+    gGourceSettings.reorder_window = reorder_window;
+
+    RCommitLog* log = new CustomLog("tests/logs/reorder.log");
+
+    gGourceSettings.reorder_window = 0;
+
+    BOOST_REQUIRE(log->checkFormat());
+
+    return log;
+}
+
+static std::string next_filename(RCommitLog* log) {
+    RCommit commit;
+
+    while(!log->isFinished()) {
+        if(log->nextCommit(commit)) return commit.files.front().filename;
+    }
+
+    return "";
+}
+
+BOOST_AUTO_TEST_CASE( commitlog_reorder_tests )
+{
+    RCommitLog* log = open_reordered_log(3);
+
+    // sorted by time, with commits at the same time in the order read
+    BOOST_CHECK_EQUAL(next_filename(log), "/b.txt");
+
+    // the commit was read before the commits read ahead of it
+    BOOST_CHECK(log->getCommitPercent() < log->getPercent());
+
+    BOOST_CHECK_EQUAL(log->getPendingPercents().size(), 2);
+    BOOST_CHECK(*log->getPendingPercents().begin() < log->getCommitPercent());
+
+    BOOST_CHECK_EQUAL(next_filename(log), "/c.txt");
+    BOOST_CHECK_EQUAL(next_filename(log), "/d.txt");
+    BOOST_CHECK_EQUAL(next_filename(log), "/a.txt");
+    BOOST_CHECK_EQUAL(next_filename(log), "/f.txt");
+
+    // the whole log has been read but commits are still waiting
+    BOOST_CHECK(log->isFinished() == false);
+
+    BOOST_CHECK_EQUAL(next_filename(log), "/e.txt");
+    BOOST_CHECK_EQUAL(next_filename(log), "/g.txt");
+
+    BOOST_CHECK(log->isFinished());
+
+    // seeking discards the commits read ahead
+    log->seekTo(0.0f);
+
+    BOOST_CHECK(log->getPendingPercents().empty());
+
+    BOOST_CHECK_EQUAL(next_filename(log), "/b.txt");
+    BOOST_CHECK_EQUAL(next_filename(log), "/c.txt");
+
+    log->seekTo(0.0f);
+
+    BOOST_CHECK_EQUAL(next_filename(log), "/b.txt");
+
+    delete log;
+
+    // without a window commits are returned as read
+    log = open_reordered_log(0);
+
+    BOOST_CHECK_EQUAL(next_filename(log), "/a.txt");
+    BOOST_CHECK_EQUAL(next_filename(log), "/b.txt");
+
+    delete log;
+}
@@ -0,0 +1,90 @@
+/*
+    This program is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation; either version
+    3 of the License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "../formats/merged.h"
+#include "../formats/custom.h"
+
+#include <boost/test/unit_test.hpp>
+
+static RCommitLog* open_custom_log(const std::string& logfile) {
+    RCommitLog* log = new CustomLog(logfile);
+
+    BOOST_REQUIRE(log->checkFormat());
+
+    return log;
+}
+
+BOOST_AUTO_TEST_CASE( merged_log_order_tests )
+{
+    RMergedCommitLog merged;
+
+    merged.addLog(open_custom_log("tests/logs/merge-a.log"), "/a");
+    merged.addLog(open_custom_log("tests/logs/merge-b.log"), "/b");
+
+    std::vector<time_t> timestamps;
+    std::vector<std::string> filenames;
+
+    RCommit commit;
+
+    while(!merged.isFinished()) {
+        if(!merged.nextCommit(commit)) continue;
+
+        timestamps.push_back(commit.timestamp);
+        filenames.push_back(commit.files.front().filename);
+    }
+
+    // commits at the same time are in the order the logs were added
+    BOOST_REQUIRE_EQUAL(filenames.size(), 6);
+
+    BOOST_CHECK_EQUAL(timestamps[0], 1277787455);
+    BOOST_CHECK_EQUAL(filenames[0], "/a/a.txt");
+
+    BOOST_CHECK_EQUAL(timestamps[1], 1277787456);
+    BOOST_CHECK_EQUAL(filenames[1], "/b/c.txt");
+
+    BOOST_CHECK_EQUAL(timestamps[2], 1277787457);
+    BOOST_CHECK_EQUAL(filenames[2], "/a/a.txt");
+
+    BOOST_CHECK_EQUAL(timestamps[3], 1277787457);
+    BOOST_CHECK_EQUAL(filenames[3], "/b/d.txt");
+
+    BOOST_CHECK_EQUAL(timestamps[4], 1277787460);
+    BOOST_CHECK_EQUAL(filenames[4], "/a/b.txt");
+
+    BOOST_CHECK_EQUAL(timestamps[5], 1277787461);
+    BOOST_CHECK_EQUAL(filenames[5], "/b/c.txt");
+}
+
+BOOST_AUTO_TEST_CASE( merged_log_prefix_tests )
+{
+    BOOST_CHECK_EQUAL(RMergedCommitLog::getLogName("/src/project"),  "/project");
+    BOOST_CHECK_EQUAL(RMergedCommitLog::getLogName("/src/project/"), "/project");
+    BOOST_CHECK_EQUAL(RMergedCommitLog::getLogName("/"), "/log");
+
+    // logs with the same name are numbered in the order they are added
+    RMergedCommitLog merged;
+
+    BOOST_CHECK_EQUAL(merged.getLogPrefix("/src/project"),       "/project");
+    BOOST_CHECK_EQUAL(merged.getLogPrefix("/src/other"),         "/other");
+    BOOST_CHECK_EQUAL(merged.getLogPrefix("/backup/project/"),   "/project-2");
+    BOOST_CHECK_EQUAL(merged.getLogPrefix("/old/project"),       "/project-3");
+
+    // numbers already used by another log's name are skipped
+    RMergedCommitLog numbered;
+
+    BOOST_CHECK_EQUAL(numbered.getLogPrefix("/x/project"),   "/project");
+    BOOST_CHECK_EQUAL(numbered.getLogPrefix("/y/project-2"), "/project-2");
+    BOOST_CHECK_EQUAL(numbered.getLogPrefix("/z/project"),   "/project-3");
+    BOOST_CHECK_EQUAL(numbered.getLogPrefix("/w/project-2"), "/project-2-2");
+}
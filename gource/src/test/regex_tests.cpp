@@ -43,3 +43,59 @@ BOOST_AUTO_TEST_CASE( regex_tests )
     BOOST_CHECK_EQUAL(matches.size(), 1);
     BOOST_CHECK_EQUAL(matches[0], "123");
 }
+
+BOOST_AUTO_TEST_CASE( regex_filter_tests )
+{
+    RegexFilter filter;
+    BOOST_CHECK(filter.empty());
+    BOOST_CHECK(filter.match("/src/main.cpp") == false);
+
+    filter.add("\\.png$");
+    filter.add("^/vendor/");
+    filter.add("(?i)readme");
+    BOOST_CHECK_EQUAL(filter.size(), 3);
+    BOOST_CHECK(filter.isCombined());
+
+    BOOST_CHECK(filter.match("/data/file.png"));
+    BOOST_CHECK(filter.match("/vendor/lib.c"));
+    BOOST_CHECK(filter.match("/README.md"));
+    BOOST_CHECK(filter.match("/src/vendor/lib.c") == false);
+    BOOST_CHECK(filter.match("/src/main.cpp") == false);
+
+    // cached result
+    BOOST_CHECK(filter.match("/data/file.png"));
+
+    // inline options are scoped to their own expression
+    BOOST_CHECK(filter.match("/DATA/FILE.PNG") == false);
+
+    // every expression must match
+    RegexFilter show_filter(true);
+    show_filter.add("^/src/");
+    show_filter.add("\\.cpp$");
+    BOOST_CHECK(show_filter.isCombined());
+
+    BOOST_CHECK(show_filter.match("/src/main.cpp"));
+    BOOST_CHECK(show_filter.match("/src/main.h") == false);
+    BOOST_CHECK(show_filter.match("/test/main.cpp") == false);
+    BOOST_CHECK(show_filter.match("") == false);
+
+    // expressions using back references are matched individually
+    RegexFilter backref_filter;
+    backref_filter.add("(a)\\1");
+    backref_filter.add("(b)\\1");
+    BOOST_CHECK(backref_filter.isCombined() == false);
+    BOOST_CHECK(backref_filter.match("xaa"));
+    BOOST_CHECK(backref_filter.match("xbb"));
+    BOOST_CHECK(backref_filter.match("xab") == false);
+
+    // invalid expressions are not added
+    BOOST_CHECK(backref_filter.add("(unclosed") == false);
+    BOOST_CHECK_EQUAL(backref_filter.size(), 2);
+
+    RegexFilter filter_copy = filter;
+    BOOST_CHECK(filter_copy.match("/vendor/lib.c"));
+
+    filter.clear();
+    BOOST_CHECK(filter.empty());
+    BOOST_CHECK(filter.match("/vendor/lib.c") == false);
+}
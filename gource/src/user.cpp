@@ -49,7 +49,7 @@ RUser::RUser(const std::string& name, vec2 pos, int tagid) : Pawn(name,pos,tagid
 
     min_units_ps = 100.0;
 
-    actionCount = activeCount = 0;
+    activeCount = 0;
 }
 
 void RUser::addAction(RAction* action) {
@@ -59,23 +59,18 @@ void RUser::addAction(RAction* action) {
     if(isIdle()) showName();
     //name_interval = name_interval > 0.0 ? std::max(name_interval,nametime-1.0f) : nametime;
 
-    actions.push_back(action);
-    actionCount++;
+    actions.push(action);
 }
 
 // remove references to this file
 void RUser::fileRemoved(RFile* f) {
 
-    for(std::list<RAction*>::iterator it = actions.begin(); it != actions.end(); ) {
-        RAction* a = *it;
-        if(a->target == f) {
-            it = actions.erase(it);
-            delete a;
-            actionCount--;
-            continue;
-        }
+    std::vector<RAction*> removed;
 
-        it++;
+    actions.removeTarget(f, removed);
+
+    for(size_t i = 0; i < removed.size(); i++) {
+        delete removed[i];
     }
 
     for(std::list<RAction*>::iterator it = activeActions.begin(); it != activeActions.end(); ) {
@@ -167,13 +162,7 @@ void RUser::applyForceToActions() {
     if(!activeActions.empty()) return;
 
     //if no actions being worked on, move towards one pending action
-    for(std::list<RAction*>::iterator it = actions.begin(); it != actions.end(); it++) {
-        RAction* action = *it;
-
-        applyForceAction(action);
-
-        break;
-    }
+    if(!actions.empty()) applyForceAction(actions.front());
 }
 
 void RUser::colourize() {
@@ -181,27 +170,26 @@ void RUser::colourize() {
 }
 
 void RUser::assignUserImage() {
-    colourize();
-
     TextureResource* graphic = 0;
 
+    bool user_image = false;
+
     if(gGourceSettings.user_image_dir.size() > 0) {
 
         //try their username
-        // TODO: replace with map of name -> image of all pngs and jpgs in directory
-        //gGourceSettings.user_image_dir + name + std::string(".jpg");
-
-        std::map<std::string, std::string>::iterator findimage;
-
-        findimage = gGourceSettings.user_image_map.find(name);
+        std::string imagefile;
 
         //do we have this image
-        if(findimage != gGourceSettings.user_image_map.end()) {
-            std::string imagefile = findimage->second;
-
-            if(!gGourceSettings.colour_user_images) usercol = vec3(1.0, 1.0, 1.0);
-
-            graphic = texturemanager.grabFile(imagefile, true, GL_CLAMP_TO_EDGE);
+        if(gGourceSettings.findUserImage(name, imagefile)) {
+
+            //already loaded for another user, otherwise use the default
+            //image until it has been loaded in the background
+            if(texturemanager.isLoaded(imagefile)) {
+                graphic = texturemanager.grabFile(imagefile, true, GL_CLAMP_TO_EDGE);
+                user_image = true;
+            } else {
+                pending_image = imagefile;
+            }
         }
     }
 
@@ -212,8 +200,8 @@ void RUser::assignUserImage() {
     //nope
     if(!graphic) {
         if(gGourceSettings.default_user_image.size() > 0) {
-            if(!gGourceSettings.colour_user_images) usercol = vec3(1.0, 1.0, 1.0);
             graphic = texturemanager.grabFile(gGourceSettings.default_user_image, true, GL_CLAMP_TO_EDGE);
+            user_image = true;
         } else {
             graphic = texturemanager.grab("user.png", true, GL_CLAMP_TO_EDGE);
         }
@@ -221,16 +209,44 @@ void RUser::assignUserImage() {
 
     setGraphic(graphic);
 
+    updateColour(user_image);
+}
+
+//images are drawn uncoloured unless requested
+void RUser::updateColour(bool user_image) {
+    colourize();
+
+    if(user_image && !gGourceSettings.colour_user_images) usercol = vec3(1.0, 1.0, 1.0);
+
     usercol = usercol * 0.6f + vec3(1.0f) * 0.4f;
     usercol *= 0.9f;
 }
 
+const std::string& RUser::getPendingImage() const {
+    return pending_image;
+}
+
+// the requested image has loaded, or failed to if graphic is 0, in which
+// case the default image is kept
+void RUser::setUserImage(TextureResource* graphic) {
+    pending_image.clear();
+
+    if(graphic == 0) return;
+
+    //release the default image
+    if(this->graphic != 0) texturemanager.release(this->graphic);
+
+    setGraphic(graphic);
+
+    updateColour(true);
+}
+
 int RUser::getActionCount() {
-    return actionCount + activeCount;
+    return actions.size() + activeCount;
 }
 
 int RUser::getPendingActionCount() {
-    return actionCount;
+    return actions.size();
 }
 
 void RUser::logic(float t, float dt) {
@@ -238,44 +254,30 @@ void RUser::logic(float t, float dt) {
 
     action_interval -= dt;
 
-    bool find_nearby_action = false;
-
-    if(!actions.empty() && action_interval <= 0) {
-        find_nearby_action = true;
-    }
+    //add all files which are too old
+    if(gGourceSettings.max_file_lag>=0.0) {
+        RAction* action;
 
-    //add next active action, if it is in range
-    for(std::list<RAction*>::iterator it = actions.begin(); it != actions.end();) {
-        RAction* action = *it;
-
-        //add all files which are too old
-        if(gGourceSettings.max_file_lag>=0.0 && action->t < t - gGourceSettings.max_file_lag) {
-            it = actions.erase(it);
-            actionCount--;
+        while((action = actions.popOlderThan(t - gGourceSettings.max_file_lag)) != 0) {
             action->rate = 2.0;
             activeActions.push_back(action);
             activeCount++;
-            continue;
         }
+    }
 
-        if(!find_nearby_action) break;
-
-        float action_dist = glm::length(action->target->getAbsolutePos() - pos);
+    //add next active action, if it is in range
+    if(!actions.empty() && action_interval <= 0) {
+        RAction* action = actions.popInRange(pos, gGourceBeamDist);
 
-        //queue first action in range
-        if(action_dist < gGourceBeamDist) {
-            it = actions.erase(it);
+        if(action != 0) {
             activeActions.push_back(action);
-            actionCount--; activeCount++;
-            break;
+            activeCount++;
         }
-
-        it++;
     }
 
     //reset action interval
     if(action_interval <= 0) {
-        int total_actions = actionCount + activeCount;
+        int total_actions = actions.size() + activeCount;
 
         action_interval = total_actions ? (1.0 / (float)total_actions) : 1.0;
     }
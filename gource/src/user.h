@@ -23,6 +23,7 @@
 #include "pawn.h"
 #include "action.h"
 #include "file.h"
+#include "actionqueue.h"
 
 #include "sys/stat.h"
 
@@ -35,9 +36,8 @@ class RUser : public Pawn {
 
     void assignUserImage();
 
-    std::list<RAction*> actions;
+    RActionQueue actions;
     std::list<RAction*> activeActions;
-    size_t actionCount;
     size_t activeCount;
 
     float action_interval;
@@ -50,11 +50,14 @@ class RUser : public Pawn {
     std::string name;
     vec3 usercol;
 
+    std::string pending_image;
+
     bool highlighted;
 
     bool nameVisible() const;
 
     void updateFont();
+    void updateColour(bool user_image);
     const vec3& getNameColour() const;
     void drawNameText(float alpha);
 public:
@@ -65,6 +68,9 @@ public:
 
     const std::string& getName() const;
 
+    const std::string& getPendingImage() const;
+    void setUserImage(TextureResource* graphic);
+
     void fileRemoved(RFile* f);
     void addAction(RAction* action);
 
@@ -40,6 +40,36 @@ ZoomCamera::ZoomCamera(vec3 pos, vec3 target, float min_distance, float max_dist
 void ZoomCamera::reset() {
     pos    = _pos;
     target = _target;
+
+    rotation     = 0.0f;
+    rotation_sin = 0.0f;
+    rotation_cos = 1.0f;
+
+    up = vec3(0.0f, -1.0f, 0.0f);
+}
+
+// turn the view so the world appears rotated by angle on screen
+void ZoomCamera::rotate(float angle) {
+    rotation += angle;
+
+    rotation_sin = sinf(rotation);
+    rotation_cos = cosf(rotation);
+
+    up = vec3(viewToWorld(vec2(0.0f, -1.0f)), 0.0f);
+}
+
+// direction in the world of an offset along the axes of the screen
+vec2 ZoomCamera::viewToWorld(const vec2& offset) const {
+    return rotate_vec2(offset, -rotation_sin, rotation_cos);
+}
+
+// width and height the bounds cover along the axes of the screen
+vec2 ZoomCamera::getViewDimensions(const Bounds2D& bounds) const {
+    float s = fabs(rotation_sin);
+    float c = fabs(rotation_cos);
+
+    return vec2( c * bounds.width() + s * bounds.height(),
+                 s * bounds.width() + c * bounds.height() );
 }
 
 float ZoomCamera::getMaxDistance() { return max_distance; }
@@ -109,9 +139,11 @@ void ZoomCamera::adjust(const Bounds2D& bounds, bool adjust_distance) {
 
     if(!adjust_distance) return;
 
+    vec2 view_dims = getViewDimensions(bounds);
+
     //scale by 10% so we dont have stuff right on the edge of the screen
-    float width  = bounds.width() * padding;
-    float height = bounds.height() * padding;
+    float width  = view_dims.x * padding;
+    float height = view_dims.y * padding;
 
     float aspect_ratio = display.width / (float) display.height;
 
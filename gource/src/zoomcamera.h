@@ -41,6 +41,11 @@ class ZoomCamera {
 
     float fov;
     float znear, zfar;
+
+    // rotation of the view around its axis. the world is laid out
+    // once and the camera turns instead of every position in it.
+    float rotation;
+    float rotation_sin, rotation_cos;
 public:
     ZoomCamera();
     ZoomCamera(vec3 start, vec3 target, float min_distance, float max_distance);
@@ -63,6 +68,12 @@ public:
     float getZFar()  { return zfar; };
     
     void setPos(const vec3& pos, bool keep_angle = false);
+
+    float getRotation() const { return rotation; };
+    void rotate(float angle);
+
+    vec2 viewToWorld(const vec2& offset) const;
+    vec2 getViewDimensions(const Bounds2D& bounds) const;
     
     float getMinDistance();
     float getMaxDistance();
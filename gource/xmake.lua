@@ -23,14 +23,19 @@ add_requires("zlib", {system = false})
 local src_files = {
     "src/main.cpp",
     "src/action.cpp",
+    "src/actionqueue.cpp",
+    "src/activity.cpp",
+    "src/avatars.cpp",
     "src/bloom.cpp",
     "src/caption.cpp",
     "src/dirnode.cpp",
     "src/file.cpp",
+    "src/filestore.cpp",
     "src/gource.cpp",
     "src/gource_shell.cpp",
     "src/gource_settings.cpp",
     "src/key.cpp",
+    "src/labelgrid.cpp",
     "src/logmill.cpp",
     "src/pawn.cpp",
     "src/slider.cpp",
@@ -47,6 +52,7 @@ local src_files = {
     "src/formats/git.cpp",
     "src/formats/gitraw.cpp",
     "src/formats/hg.cpp",
+    "src/formats/merged.cpp",
     "src/formats/svn.cpp",
     "src/core/conffile.cpp",
     "src/core/display.cpp",
@@ -66,7 +72,9 @@ local src_files = {
     "src/core/shader.cpp",
     "src/core/shader_common.cpp",
     "src/core/stringhash.cpp",
+    "src/core/stringtable.cpp",
     "src/core/texture.cpp",
+    "src/core/tiled_render.cpp",
     "src/core/timezone.cpp",
     "src/core/vbo.cpp",
     "src/core/vectors.cpp",